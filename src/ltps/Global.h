@@ -28,6 +28,7 @@
 
 
 #include "ll/api/i18n/I18n.h"
+#include <cstdint>
 #include <expected>
 namespace ltps {
 
@@ -38,5 +39,6 @@ template <typename T, typename E = std::string>
 using Result = std::expected<T, E>;
 
 using RealName = std::string;
+using PlayerId = std::uint32_t; // PlayerRegistry 分配的紧凑玩家 ID
 
 } // namespace ltps
\ No newline at end of file
@@ -25,7 +25,7 @@ namespace ltps {
 
 #ifdef TPS_TEST
 namespace test {
-extern void Test_Main();
+extern bool Test_Main();
 }
 #endif
 
@@ -53,7 +53,8 @@ bool TeleportSystem::load() {
         std::chrono::milliseconds{30},
         16
     );
-    mStorageManager = std::unique_ptr<StorageManager>(new StorageManager(*mThreadPool));
+    mTimerService   = std::make_unique<TimerService>(*mThreadPool);
+    mStorageManager = std::unique_ptr<StorageManager>(new StorageManager(*mThreadPool, *mTimerService));
     mModuleManager  = std::unique_ptr<ModuleManager>(new ModuleManager());
 
     // 初始化全局配置
@@ -86,7 +87,10 @@ bool TeleportSystem::enable() {
     BaseCommand::setup();            // 基础命令
 
 #ifdef TPS_TEST
-    test::Test_Main();
+    if (!test::Test_Main()) {
+        mSelf.getLogger().error("Tests failed, see the output above");
+        return false;
+    }
 #endif
 
     return true;
@@ -99,6 +103,7 @@ bool TeleportSystem::disable() {
 
     mModuleManager.reset();        // 销毁模块管理器指针
     mStorageManager.reset();       // 销毁 Storage 指针
+    mTimerService.reset();         // 停止定时器线程, 取消剩余定时器
     mServerThreadExecutor.reset(); // 销毁 Server 线程池指针
     mThreadPool->destroy();        // 销毁线程池
     mThreadPool.reset();           // 销毁线程池指针
@@ -116,6 +121,7 @@ ll::thread::ThreadPoolExecutor&         TeleportSystem::getThreadPool() { return
 ll::thread::ServerThreadExecutor const& TeleportSystem::getServerThreadExecutor() const {
     return *mServerThreadExecutor;
 }
+TimerService&   TeleportSystem::getTimerService() { return *mTimerService; }
 StorageManager& TeleportSystem::getStorageManager() { return *mStorageManager; }
 ModuleManager&  TeleportSystem::getModuleManager() { return *mModuleManager; }
 
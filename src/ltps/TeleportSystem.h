@@ -4,6 +4,7 @@
 #include "ll/api/mod/NativeMod.h"
 #include "ll/api/thread/ThreadPoolExecutor.h"
 
+#include "ltps/common/TimerService.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/ModuleManager.h"
 
@@ -30,6 +31,8 @@ class TeleportSystem {
 
     [[nodiscard]] ll::thread::ServerThreadExecutor const& getServerThreadExecutor() const;
 
+    [[nodiscard]] TimerService& getTimerService();
+
     [[nodiscard]] StorageManager& getStorageManager();
 
     [[nodiscard]] ModuleManager& getModuleManager();
@@ -40,6 +43,7 @@ class TeleportSystem {
     ll::mod::NativeMod&                               mSelf;
     std::unique_ptr<ll::thread::ThreadPoolExecutor>   mThreadPool;
     std::unique_ptr<ll::thread::ServerThreadExecutor> mServerThreadExecutor;
+    std::unique_ptr<TimerService>                     mTimerService;
     std::unique_ptr<StorageManager>                   mStorageManager;
     std::unique_ptr<ModuleManager>                    mModuleManager;
 };
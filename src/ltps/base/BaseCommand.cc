@@ -5,10 +5,13 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/Version.h"
 #include "ltps/base/Config.h"
+#include "ltps/common/BlockPool.h"
 #include "ltps/database/PermissionStorage.h"
 #include "ltps/database/StorageManager.h"
 #include "ltps/modules/ModuleManager.h"
 #include "ltps/modules/setting/gui/SettingGUI.h"
+#include "ltps/modules/tpa/TpaModule.h"
+#include "ltps/modules/tpa/TpaRequest.h"
 #include "ltps/utils/McUtils.h"
 #include "mc/server/commands/CommandOrigin.h"
 #include "mc/server/commands/CommandOriginType.h"
@@ -68,11 +71,107 @@ void BaseCommand::setup() {
         }
 
         loadConfig();
+        TeleportSystem::getInstance().getStorageManager().postConfigReload();
         TeleportSystem::getInstance().getModuleManager().reconfigureModules();
         EconomySystemManager::getInstance().reloadEconomySystem();
         mc_utils::sendText(output, "配置已重载"_tr());
     });
 
+    // ltps storage # [控制台] 查看存储回写统计
+    cmd.overload().text("storage").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        if (origin.getOriginType() != CommandOriginType::DedicatedServer) {
+            mc_utils::sendText<mc_utils::Error>(output, "此命令只能在服务器端执行"_tr());
+            return;
+        }
+
+        auto& manager = TeleportSystem::getInstance().getStorageManager();
+        mc_utils::sendText(
+            output,
+            "存储回写: 已回写 {} 次, 无变更跳过 {} 次"_tr(
+                manager.getWriteBackCount(),
+                manager.getSkippedWriteBackCount()
+            )
+        );
+        mc_utils::sendText(
+            output,
+            "预写日志: 待压缩 {} 条记录, {} 字节"_tr(manager.getJournal().getRecords(), manager.getJournal().getBytes())
+        );
+
+        auto stats = manager.getLastWriteBackStats();
+        mc_utils::sendText(
+            output,
+            "上次回写: {} 个存储, {} 个键, {} 字节, 编码 {} μs, 提交 {} μs"_tr(
+                stats.storages,
+                stats.operations,
+                stats.bytes,
+                stats.collectTime.count(),
+                stats.commitTime.count()
+            )
+        );
+        mc_utils::sendText(
+            output,
+            "回写调度: 距上次回写 {} 秒, 平均 tick 间隔 {} ms, 负载过高推迟 {} 次"_tr(
+                manager.getTimeSinceLastWriteBack().count(),
+                manager.getTickInterval().count(),
+                manager.getDeferredWriteBackCount()
+            )
+        );
+    });
+
+    // ltps flush # [控制台] 立即回写所有存储
+    cmd.overload().text("flush").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        if (origin.getOriginType() != CommandOriginType::DedicatedServer) {
+            mc_utils::sendText<mc_utils::Error>(output, "此命令只能在服务器端执行"_tr());
+            return;
+        }
+        TeleportSystem::getInstance().getStorageManager().requestWriteBack();
+        mc_utils::sendText(output, "已请求立即回写, 使用 /ltps storage 查看结果"_tr());
+    });
+
+    // ltps tpa # [控制台] 查看 TPA 请求过期发布与回收池统计
+    cmd.overload().text("tpa").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        if (origin.getOriginType() != CommandOriginType::DedicatedServer) {
+            mc_utils::sendText<mc_utils::Error>(output, "此命令只能在服务器端执行"_tr());
+            return;
+        }
+
+        auto module = TeleportSystem::getInstance().getModuleManager().getModule<tpa::TpaModule>(tpa::TpaModule::name);
+        if (!module || !module->isEnabled()) {
+            mc_utils::sendText<mc_utils::Error>(output, "TPA 模块未启用"_tr());
+            return;
+        }
+
+        auto stats = module->getRequestPool().getExpirationStats();
+        mc_utils::sendText(
+            output,
+            "过期请求: 到期 {} 个, 发布 {} 个, 共 {} 个批次"_tr(stats.expired, stats.published, stats.batches)
+        );
+        mc_utils::sendText(output, "批次大小: 上次 {} 个, 最多 {} 个"_tr(stats.lastBatch, stats.maxBatch));
+        mc_utils::sendText(
+            output,
+            "服务器线程耗时: 上次 {} μs, 最长 {} μs, 累计 {} μs"_tr(
+                stats.lastTime.count(),
+                stats.maxTime.count(),
+                stats.totalTime.count()
+            )
+        );
+
+        auto sendPoolStats = [&output](std::string const& name, BlockPool::Stats const& pool) {
+            mc_utils::sendText(
+                output,
+                "{}: 堆分配 {} 次, 复用 {} 次, 使用中 {} 个, 空闲 {} 个"_tr(
+                    name,
+                    pool.heapAllocations,
+                    pool.reused,
+                    pool.inUse,
+                    pool.free
+                )
+            );
+        };
+        sendPoolStats("请求回收池"_tr(), tpa::TpaRequest::getPoolStats());
+        sendPoolStats("Impl 回收池"_tr(), tpa::TpaRequest::getImplPoolStats());
+    });
+
     // ltps setting
     cmd.overload().text("setting").execute([](CommandOrigin const& origin, CommandOutput& output) {
         if (origin.getOriginType() != CommandOriginType::Player) {
@@ -18,9 +18,23 @@ namespace v5 {
 using DisallowedDimensions = std::unordered_set<int>;
 
 struct Config {
-    int              version  = 11;
+    int              version  = 13;
     EconomySystem::Config economySystem{};
 
+    struct {
+        bool lazyLoad      = false; // 按需加载玩家数据 (家园/死亡记录/设置), 修改后需重启生效
+        int  cacheCapacity = 256;   // 按需加载时缓存的离线玩家数量上限
+        int  evictDelay    = 300;   // 按需加载时玩家离线多久后从内存中淘汰（秒）
+
+        struct {
+            int minInterval      = 5;       // 最短回写间隔（秒）
+            int maxInterval      = 60;      // 最长回写间隔（秒）, 到期后无论服务器负载都会回写
+            int pendingMutations = 500;     // 待回写的修改数达到此值时提前回写
+            int pendingBytes     = 1 << 20; // 待回写的数据量（字节）达到此值时提前回写
+            int tickPressureMs   = 60;      // 平均 tick 间隔超过此值（毫秒）时推迟提前回写
+        } writeBack;
+    } storage;
+
     struct {
         struct {
             bool                 enable                 = true;
@@ -51,7 +65,9 @@ struct Config {
             bool                 enable               = true;
             bool                 registerBackCommand  = true; // 注册 /back 命令 (/death back的别名)
             std::string          goDeathCalculate     = "random_num_range(10, 60)";
-            int                  maxDeathInfos        = 5; // 显示给玩家的死亡信息数量
+            int                  maxDeathInfos        = 5; // 每位玩家保留的死亡信息数量
+            int                  retentionDays        = 0; // 死亡信息保留天数, 0 为永久保留 (默认, 清理需手动开启)
+            int                  maxTotalDeathInfos   = 0; // 所有玩家死亡信息总数上限, 0 为不限制 (默认)
             DisallowedDimensions disallowedDimensions = {};
         } death;
 
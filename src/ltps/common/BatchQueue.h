@@ -0,0 +1,52 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 跨线程批量投递队列（BatchQueue）
+ * 生产者在任意线程 push，消费者一次 drain 取走全部待处理元素。
+ * 队列从空变为非空时 push 返回 true，调用方据此只派发一次消费任务；drain 之后的 push 开启新的批次。
+ * drain 与调用方的缓冲区交换，两边的容量在批次之间复用。线程安全。
+ */
+template <typename T>
+class BatchQueue {
+    mutable std::mutex mMutex;
+    std::vector<T>     mPending;
+    bool               mScheduled{false}; // 当前批次已派发消费任务, 尚未 drain
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(BatchQueue);
+
+    BatchQueue() = default;
+
+    // 返回 true 表示开启了新的批次, 调用方需要派发一次消费任务
+    [[nodiscard]] bool push(T item) {
+        std::lock_guard lock{mMutex};
+        mPending.push_back(std::move(item));
+        if (mScheduled) {
+            return false;
+        }
+        mScheduled = true;
+        return true;
+    }
+
+    // 取走当前批次的全部元素, out 原有内容被丢弃
+    void drain(std::vector<T>& out) {
+        out.clear();
+        std::lock_guard lock{mMutex};
+        std::swap(out, mPending);
+        mScheduled = false;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        std::lock_guard lock{mMutex};
+        return mPending.size();
+    }
+};
+
+} // namespace ltps
@@ -0,0 +1,60 @@
+#include "ltps/common/BlockPool.h"
+
+
+namespace ltps {
+
+
+BlockPool::BlockPool(std::size_t maxFree) : mMaxFree(maxFree) {}
+
+BlockPool::~BlockPool() {
+    for (auto* block : mFree) {
+        ::operator delete(block);
+    }
+}
+
+void* BlockPool::allocate(std::size_t size) {
+    {
+        std::lock_guard lock{mMutex};
+        ++mStats.allocations;
+        if (mBlockSize == 0) {
+            mBlockSize = size;
+            mFree.reserve(mMaxFree); // 归还时不再扩容
+        }
+        if (size == mBlockSize) {
+            ++mStats.inUse;
+            if (!mFree.empty()) {
+                auto* block = mFree.back();
+                mFree.pop_back();
+                ++mStats.reused;
+                return block;
+            }
+        }
+        ++mStats.heapAllocations;
+    }
+    return ::operator new(size);
+}
+
+void BlockPool::deallocate(void* ptr, std::size_t size) {
+    {
+        std::lock_guard lock{mMutex};
+        if (size == mBlockSize) {
+            --mStats.inUse;
+            if (mFree.size() < mMaxFree) {
+                mFree.push_back(ptr);
+                return;
+            }
+        }
+    }
+    ::operator delete(ptr);
+}
+
+BlockPool::Stats BlockPool::getStats() const {
+    std::lock_guard lock{mMutex};
+
+    auto stats = mStats;
+    stats.free = mFree.size();
+    return stats;
+}
+
+
+} // namespace ltps
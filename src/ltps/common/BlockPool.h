@@ -0,0 +1,95 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 定长内存块回收池（BlockPool）
+ * 释放的内存块放回空闲列表，之后的分配优先复用，稳定状态下不再向堆申请内存；空闲块超过 maxFree 时才真正释放。
+ * 块大小由第一次分配确定，之后大小不符的请求直接转交全局 operator new。线程安全。
+ *
+ * 每个 Tag 对应一个进程内唯一的池 (BlockPool::of<Tag>())，配合 PoolAllocator 用于 std::allocate_shared：
+ * 控制块与对象在同一个块中，创建与销毁共享对象都不经过堆。
+ */
+class BlockPool {
+public:
+    struct Stats {
+        std::uint64_t allocations{0};     // 总分配次数
+        std::uint64_t reused{0};          // 复用空闲块的次数
+        std::uint64_t heapAllocations{0}; // 向堆申请内存的次数 (含大小不符的请求)
+        std::size_t   inUse{0};           // 当前借出的块数
+        std::size_t   free{0};            // 空闲列表中的块数
+    };
+
+private:
+    mutable std::mutex mMutex;
+    std::size_t        mBlockSize{0};
+    std::size_t        mMaxFree;
+    std::vector<void*> mFree;
+    Stats              mStats{};
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(BlockPool);
+
+    TPSAPI explicit BlockPool(std::size_t maxFree = 4096);
+    TPSAPI ~BlockPool();
+
+    TPSNDAPI void* allocate(std::size_t size);
+    TPSAPI void    deallocate(void* ptr, std::size_t size);
+
+    TPSNDAPI Stats getStats() const;
+
+    template <typename Tag>
+    [[nodiscard]] static BlockPool& of() {
+        static BlockPool pool;
+        return pool;
+    }
+};
+
+/**
+ * @brief 从 BlockPool::of<Tag>() 分配单个对象的分配器
+ * 一次分配多个对象或对齐要求超过 operator new 默认对齐时退回 std::allocator。
+ */
+template <typename T, typename Tag = T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, Tag>;
+    };
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(PoolAllocator<U, Tag> const&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n == 1 && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(BlockPool::of<Tag>().allocate(sizeof(T)));
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (n == 1 && alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            BlockPool::of<Tag>().deallocate(ptr, sizeof(T));
+            return;
+        }
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(PoolAllocator<U, Tag> const&) const noexcept {
+        return true;
+    }
+};
+
+} // namespace ltps
@@ -1,42 +1,92 @@
 #include "ltps/common/Cooldown.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/database/StorageManager.h"
 #include <algorithm>
 
 
 namespace ltps {
 
 
-Cooldown::Cooldown() = default;
+namespace {
+
+PlayerRegistry& getPlayerRegistry() { return TeleportSystem::getInstance().getStorageManager().getPlayerRegistry(); }
+
+TimerService& getTimerService() { return TeleportSystem::getInstance().getTimerService(); }
+
+} // namespace
+
+
+Cooldown::Cooldown() : mSelf(std::make_shared<Cooldown*>(this)) {}
+
+Cooldown::~Cooldown() {
+    mSelf.reset();
+    for (auto& [_, entry] : mCooldowns) {
+        getTimerService().cancel(entry.timer);
+    }
+}
 
 
 bool Cooldown::isCooldown(const std::string& target) const {
+    auto id = getPlayerRegistry().find(target);
+    return id && isCooldown(*id);
+}
+
+bool Cooldown::isCooldown(PlayerId target) const {
     auto it = mCooldowns.find(target);
     if (it == mCooldowns.end()) {
         return false;
     }
 
     auto now = std::chrono::steady_clock::now();
-    return now < it->second;
+    return now < it->second.endTime;
 }
 
 
 void Cooldown::setCooldown(const std::string& target, int seconds) {
-    auto endTime       = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
-    mCooldowns[target] = endTime;
+    setCooldown(getPlayerRegistry().intern(target), seconds);
+}
+
+void Cooldown::setCooldown(PlayerId target, int seconds) {
+    auto  endTime = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    auto& timers  = getTimerService();
+    if (auto it = mCooldowns.find(target); it != mCooldowns.end()) {
+        timers.cancel(it->second.timer);
+    }
+    // 冷却结束后在服务器线程移除条目, 避免表随玩家数无限增长
+    auto& entry   = mCooldowns[target];
+    entry.endTime = endTime;
+    entry.timer   = timers.scheduleAt(endTime, [self = std::weak_ptr{mSelf}, target, endTime] {
+        auto cooldown = self.lock();
+        if (!cooldown) {
+            return;
+        }
+        // 同一目标可能已重新设置冷却, 只移除本定时器对应的条目
+        auto& cooldowns = (*cooldown)->mCooldowns;
+        if (auto it = cooldowns.find(target); it != cooldowns.end() && it->second.endTime == endTime) {
+            cooldowns.erase(it);
+        }
+    });
 }
 
 
 int Cooldown::getRemainingCooldown(const std::string& target) const {
+    auto id = getPlayerRegistry().find(target);
+    return id ? getRemainingCooldown(*id) : 0;
+}
+
+int Cooldown::getRemainingCooldown(PlayerId target) const {
     auto it = mCooldowns.find(target);
     if (it == mCooldowns.end()) {
         return 0;
     }
 
     auto now = std::chrono::steady_clock::now();
-    if (now >= it->second) {
+    if (now >= it->second.endTime) {
         return 0;
     }
 
-    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(it->second - now).count();
+    auto remaining = std::chrono::duration_cast<std::chrono::seconds>(it->second.endTime - now).count();
     return static_cast<int>(remaining);
 }
 
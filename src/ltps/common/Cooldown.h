@@ -1,6 +1,8 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/TimerService.h"
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -10,12 +12,19 @@ namespace ltps {
 
 class Cooldown {
 private:
-    std::unordered_map<std::string, std::chrono::steady_clock::time_point> mCooldowns;
+    struct Entry {
+        std::chrono::steady_clock::time_point endTime;
+        TimerService::TimerId                 timer; // 到期后移除该条目
+    };
+
+    std::unordered_map<PlayerId, Entry> mCooldowns;
+    std::shared_ptr<Cooldown*>          mSelf; // 到期回调只持有其弱引用, 析构后仍在排队的回调直接跳过
 
 public:
     TPS_DISALLOW_COPY_AND_MOVE(Cooldown)
 
     TPSAPI explicit Cooldown();
+    TPSAPI ~Cooldown();
 
     // 是否正在冷却中
     TPSNDAPI bool isCooldown(const std::string& target) const;
@@ -28,6 +37,11 @@ class Cooldown {
 
     // 获取冷却字符串
     TPSNDAPI std::string getCooldownString(const std::string& target) const;
+
+    // 以 PlayerRegistry 分配的 ID 为目标, 以上接口均通过注册表转换后调用
+    TPSNDAPI bool isCooldown(PlayerId target) const;
+    TPSAPI void   setCooldown(PlayerId target, int seconds);
+    TPSNDAPI int  getRemainingCooldown(PlayerId target) const;
 };
 
 
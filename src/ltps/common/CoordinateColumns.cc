@@ -0,0 +1,218 @@
+#include "CoordinateColumns.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TPS_COORDINATE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace ltps {
+
+namespace {
+
+#ifdef TPS_COORDINATE_SSE2
+constexpr std::size_t LANES = 4;
+
+// 第 i 个点起 4 个点的距离平方
+inline __m128 distanceSquared4(
+    float const* xs,
+    float const* ys,
+    float const* zs,
+    std::size_t  i,
+    __m128       px,
+    __m128       py,
+    __m128       pz
+) {
+    auto dx = _mm_sub_ps(_mm_loadu_ps(xs + i), px);
+    auto dy = _mm_sub_ps(_mm_loadu_ps(ys + i), py);
+    auto dz = _mm_sub_ps(_mm_loadu_ps(zs + i), pz);
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+}
+
+// 第 i 个点起 4 个点中维度等于 dim 的掩码
+inline __m128 dimensionMask4(int const* dims, std::size_t i, __m128i dim) {
+    auto value = _mm_loadu_si128(reinterpret_cast<__m128i const*>(dims + i));
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(value, dim));
+}
+
+// 按掩码位追加下标
+inline void appendMasked(int mask, std::size_t base, std::vector<std::uint32_t>& out) {
+    for (std::size_t lane = 0; lane < LANES; ++lane) {
+        if (mask & (1 << lane)) {
+            out.push_back(static_cast<std::uint32_t>(base + lane));
+        }
+    }
+}
+#endif
+
+inline float scalarDistanceSquared(float dx, float dy, float dz) { return dx * dx + dy * dy + dz * dz; }
+
+} // namespace
+
+
+void CoordinateColumns::reserve(std::size_t capacity) {
+    mX.reserve(capacity);
+    mY.reserve(capacity);
+    mZ.reserve(capacity);
+    mDimid.reserve(capacity);
+}
+
+void CoordinateColumns::clear() {
+    mX.clear();
+    mY.clear();
+    mZ.clear();
+    mDimid.clear();
+}
+
+void CoordinateColumns::push_back(int dimid, float x, float y, float z) {
+    mX.push_back(x);
+    mY.push_back(y);
+    mZ.push_back(z);
+    mDimid.push_back(dimid);
+}
+
+void CoordinateColumns::set(std::size_t index, int dimid, float x, float y, float z) {
+    mX[index]     = x;
+    mY[index]     = y;
+    mZ[index]     = z;
+    mDimid[index] = dimid;
+}
+
+void CoordinateColumns::erase(std::size_t index) {
+    auto offset = static_cast<std::ptrdiff_t>(index);
+    mX.erase(mX.begin() + offset);
+    mY.erase(mY.begin() + offset);
+    mZ.erase(mZ.begin() + offset);
+    mDimid.erase(mDimid.begin() + offset);
+}
+
+void CoordinateColumns::distanceSquared(int dimid, float x, float y, float z, std::vector<float>& out) const {
+    auto const count = size();
+    out.resize(count);
+
+    std::size_t i = 0;
+#ifdef TPS_COORDINATE_SSE2
+    auto px  = _mm_set1_ps(x);
+    auto py  = _mm_set1_ps(y);
+    auto pz  = _mm_set1_ps(z);
+    auto dim = _mm_set1_epi32(dimid);
+    auto inf = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    for (; i + LANES <= count; i += LANES) {
+        auto d2   = distanceSquared4(mX.data(), mY.data(), mZ.data(), i, px, py, pz);
+        auto mask = dimensionMask4(mDimid.data(), i, dim);
+        _mm_storeu_ps(out.data() + i, _mm_or_ps(_mm_and_ps(mask, d2), _mm_andnot_ps(mask, inf)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = mDimid[i] == dimid ? scalarDistanceSquared(mX[i] - x, mY[i] - y, mZ[i] - z)
+                                    : std::numeric_limits<float>::infinity();
+    }
+}
+
+void CoordinateColumns::withinRadius(
+    int                         dimid,
+    float                       x,
+    float                       y,
+    float                       z,
+    float                       radius,
+    std::vector<std::uint32_t>& out
+) const {
+    if (!(radius >= 0)) {
+        return;
+    }
+    auto const  count = size();
+    auto const  r2    = radius * radius;
+    std::size_t i     = 0;
+#ifdef TPS_COORDINATE_SSE2
+    auto px    = _mm_set1_ps(x);
+    auto py    = _mm_set1_ps(y);
+    auto pz    = _mm_set1_ps(z);
+    auto dim   = _mm_set1_epi32(dimid);
+    auto limit = _mm_set1_ps(r2);
+    for (; i + LANES <= count; i += LANES) {
+        auto d2   = distanceSquared4(mX.data(), mY.data(), mZ.data(), i, px, py, pz);
+        auto mask = _mm_and_ps(_mm_cmple_ps(d2, limit), dimensionMask4(mDimid.data(), i, dim));
+        if (auto bits = _mm_movemask_ps(mask); bits != 0) {
+            appendMasked(bits, i, out);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (mDimid[i] == dimid && scalarDistanceSquared(mX[i] - x, mY[i] - y, mZ[i] - z) <= r2) {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+void CoordinateColumns::withinBox(
+    int                         dimid,
+    float                       minX,
+    float                       minY,
+    float                       minZ,
+    float                       maxX,
+    float                       maxY,
+    float                       maxZ,
+    std::vector<std::uint32_t>& out
+) const {
+    auto const  count = size();
+    std::size_t i     = 0;
+#ifdef TPS_COORDINATE_SSE2
+    auto lowX  = _mm_set1_ps(minX);
+    auto lowY  = _mm_set1_ps(minY);
+    auto lowZ  = _mm_set1_ps(minZ);
+    auto highX = _mm_set1_ps(maxX);
+    auto highY = _mm_set1_ps(maxY);
+    auto highZ = _mm_set1_ps(maxZ);
+    auto dim   = _mm_set1_epi32(dimid);
+    for (; i + LANES <= count; i += LANES) {
+        auto vx   = _mm_loadu_ps(mX.data() + i);
+        auto vy   = _mm_loadu_ps(mY.data() + i);
+        auto vz   = _mm_loadu_ps(mZ.data() + i);
+        auto inX  = _mm_and_ps(_mm_cmpge_ps(vx, lowX), _mm_cmple_ps(vx, highX));
+        auto inY  = _mm_and_ps(_mm_cmpge_ps(vy, lowY), _mm_cmple_ps(vy, highY));
+        auto inZ  = _mm_and_ps(_mm_cmpge_ps(vz, lowZ), _mm_cmple_ps(vz, highZ));
+        auto mask = _mm_and_ps(_mm_and_ps(inX, inY), _mm_and_ps(inZ, dimensionMask4(mDimid.data(), i, dim)));
+        if (auto bits = _mm_movemask_ps(mask); bits != 0) {
+            appendMasked(bits, i, out);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (mDimid[i] == dimid && mX[i] >= minX && mX[i] <= maxX && mY[i] >= minY && mY[i] <= maxY && mZ[i] >= minZ
+            && mZ[i] <= maxZ) {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+std::vector<CoordinateColumns::Hit>
+CoordinateColumns::nearest(int dimid, float x, float y, float z, std::size_t limit, float maxDistance) const {
+    std::vector<Hit> hits;
+    if (limit == 0 || empty() || !(maxDistance >= 0)) {
+        return hits;
+    }
+    std::vector<float> distances;
+    distanceSquared(dimid, x, y, z, distances);
+
+    auto const inf    = std::numeric_limits<float>::infinity();
+    auto const limit2 = maxDistance * maxDistance;
+    for (std::uint32_t i = 0; i < distances.size(); ++i) {
+        if (distances[i] <= limit2 && distances[i] < inf) { // 其它维度的点为 +inf
+            hits.push_back({i, std::sqrt(distances[i])});
+        }
+    }
+
+    auto less = [](Hit const& lhs, Hit const& rhs) { return lhs.distance < rhs.distance; };
+    if (hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(limit), hits.end(), less);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), less);
+    }
+    return hits;
+}
+
+
+} // namespace ltps
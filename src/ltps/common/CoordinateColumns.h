@@ -0,0 +1,76 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 坐标列存副本（CoordinateColumns）
+ * 将记录的坐标与维度按列 (x[], y[], z[], dimid[]) 保存在记录数组旁边，下标与记录数组一一对应，
+ * 批量几何查询只需顺序读取这四列，不必遍历夹杂名称与时间的记录结构体。
+ *
+ * 距离与范围筛选在支持 SSE2 的平台上每次处理 4 个点，其余平台使用标量实现，两者结果一致。
+ * 查询结果均为升序下标；非线程安全，由调用方保证同步。
+ */
+class CoordinateColumns {
+public:
+    struct Hit {
+        std::uint32_t index;
+        float         distance;
+    };
+
+private:
+    std::vector<float> mX;
+    std::vector<float> mY;
+    std::vector<float> mZ;
+    std::vector<int>   mDimid;
+
+public:
+    [[nodiscard]] std::size_t size() const { return mDimid.size(); }
+    [[nodiscard]] bool        empty() const { return mDimid.empty(); }
+
+    [[nodiscard]] float x(std::size_t index) const { return mX[index]; }
+    [[nodiscard]] float y(std::size_t index) const { return mY[index]; }
+    [[nodiscard]] float z(std::size_t index) const { return mZ[index]; }
+    [[nodiscard]] int   dimid(std::size_t index) const { return mDimid[index]; }
+
+    TPSAPI void reserve(std::size_t capacity);
+    TPSAPI void clear();
+
+    TPSAPI void push_back(int dimid, float x, float y, float z);
+    TPSAPI void set(std::size_t index, int dimid, float x, float y, float z);
+    TPSAPI void erase(std::size_t index); // 保持顺序, 与 vector::erase 一致
+
+    // 每个点到 (x, y, z) 的距离平方, 写入 out[0, size()), 其它维度的点为 +inf
+    TPSAPI void distanceSquared(int dimid, float x, float y, float z, std::vector<float>& out) const;
+
+    // 同一维度内到 (x, y, z) 的距离不超过 radius 的点, 追加到 out
+    TPSAPI void withinRadius(int dimid, float x, float y, float z, float radius, std::vector<std::uint32_t>& out) const;
+
+    // 同一维度内位于轴对齐包围盒 [min, max] (含边界) 内的点, 追加到 out
+    TPSAPI void withinBox(
+        int                         dimid,
+        float                       minX,
+        float                       minY,
+        float                       minZ,
+        float                       maxX,
+        float                       maxY,
+        float                       maxZ,
+        std::vector<std::uint32_t>& out
+    ) const;
+
+    // 同一维度内距离最近的至多 limit 个点 (不超过 maxDistance), 按距离升序
+    TPSNDAPI std::vector<Hit> nearest(
+        int         dimid,
+        float       x,
+        float       y,
+        float       z,
+        std::size_t limit,
+        float       maxDistance = std::numeric_limits<float>::infinity()
+    ) const;
+};
+
+} // namespace ltps
@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 开放寻址哈希表（FlatHashMap）
+ * 键值对直接存放在一块连续的槽位数组中，线性探测，负载超过 3/4 时容量翻倍；
+ * 删除时把后续探测链上的元素向前移动 (backward shift)，不留墓碑，查找长度不会随删除退化。
+ *
+ * 哈希值会再经过一次 64 位混淆，因此 Hash 只需保证相等的键哈希相等。
+ * find 返回的指针在下一次插入 / 删除之前有效。非线程安全，由调用方保证同步。
+ */
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap {
+    struct Slot {
+        Key  key{};
+        T    value{};
+        bool used{false};
+    };
+
+    std::vector<Slot> mSlots;
+    std::size_t       mSize{0};
+    std::size_t       mMask{0};
+
+    [[no_unique_address]] Hash     mHash;
+    [[no_unique_address]] KeyEqual mEqual;
+
+    [[nodiscard]] std::size_t indexOf(Key const& key) const {
+        auto h  = static_cast<std::uint64_t>(mHash(key));
+        h      ^= h >> 33;
+        h      *= 0xff51afd7ed558ccdULL;
+        h      ^= h >> 33;
+        return static_cast<std::size_t>(h) & mMask;
+    }
+
+    // 返回 key 所在槽位, 不存在时返回探测终止处的空槽位
+    [[nodiscard]] std::size_t probe(Key const& key) const {
+        auto index = indexOf(key);
+        while (mSlots[index].used && !mEqual(mSlots[index].key, key)) {
+            index = (index + 1) & mMask;
+        }
+        return index;
+    }
+
+    void rehash(std::size_t capacity) {
+        auto old = std::exchange(mSlots, std::vector<Slot>(capacity));
+        mMask    = capacity - 1;
+        for (auto& slot : old) {
+            if (slot.used) {
+                auto& target = mSlots[probe(slot.key)];
+                target.key   = std::move(slot.key);
+                target.value = std::move(slot.value);
+                target.used  = true;
+            }
+        }
+    }
+
+public:
+    [[nodiscard]] std::size_t size() const { return mSize; }
+    [[nodiscard]] bool        empty() const { return mSize == 0; }
+    [[nodiscard]] std::size_t capacity() const { return mSlots.size(); }
+
+    void reserve(std::size_t count) {
+        auto capacity = std::bit_ceil(std::max<std::size_t>(16, count + count / 3 + 1));
+        if (capacity > mSlots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    [[nodiscard]] T* find(Key const& key) {
+        if (mSize == 0) {
+            return nullptr;
+        }
+        auto& slot = mSlots[probe(key)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    [[nodiscard]] T const* find(Key const& key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    [[nodiscard]] bool contains(Key const& key) const { return find(key) != nullptr; }
+
+    // 键不存在时插入 value, 返回值的指针以及是否插入
+    std::pair<T*, bool> try_emplace(Key const& key, T value = T{}) {
+        if ((mSize + 1) * 4 > mSlots.size() * 3) {
+            reserve(std::max<std::size_t>(mSize * 2, 16));
+        }
+        auto& slot = mSlots[probe(key)];
+        if (slot.used) {
+            return {&slot.value, false};
+        }
+        slot.key   = key;
+        slot.value = std::move(value);
+        slot.used  = true;
+        ++mSize;
+        return {&slot.value, true};
+    }
+
+    bool erase(Key const& key) {
+        if (mSize == 0) {
+            return false;
+        }
+        auto hole = probe(key);
+        if (!mSlots[hole].used) {
+            return false;
+        }
+        // 把探测链上能够前移到空洞的元素依次前移
+        for (auto next = (hole + 1) & mMask; mSlots[next].used; next = (next + 1) & mMask) {
+            auto home = indexOf(mSlots[next].key);
+            if (((next - home) & mMask) >= ((next - hole) & mMask)) {
+                mSlots[hole].key   = std::move(mSlots[next].key);
+                mSlots[hole].value = std::move(mSlots[next].value);
+                hole               = next;
+            }
+        }
+        mSlots[hole] = Slot{};
+        --mSize;
+        return true;
+    }
+
+    void clear() {
+        for (auto& slot : mSlots) {
+            slot = Slot{};
+        }
+        mSize = 0;
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (auto const& slot : mSlots) {
+            if (slot.used) {
+                fn(slot.key, slot.value);
+            }
+        }
+    }
+};
+
+} // namespace ltps
@@ -0,0 +1,39 @@
+#include "FormPager.h"
+#include <algorithm>
+
+
+namespace ltps {
+
+
+FormPager::FormPager(std::size_t total, std::size_t page, std::size_t pageSize)
+: mTotal(total),
+  mPage(0),
+  mPageSize(std::max<std::size_t>(pageSize, 1)) {
+    mPage = std::min(page, pageCount() - 1);
+}
+
+std::string FormPager::describe(std::string const& localeCode) const {
+    return "第 {}/{} 页"_trl(localeCode, mPage + 1, pageCount());
+}
+
+void FormPager::appendButtons(ll::form::SimpleForm& fm, std::string const& localeCode, OpenPage const& open) const {
+    if (mPage > 0) {
+        fm.appendButton(
+            "上一页"_trl(localeCode),
+            "textures/ui/arrowLeft",
+            "path",
+            [open, page = mPage - 1](Player& self) { open(self, page); }
+        );
+    }
+    if (mPage + 1 < pageCount()) {
+        fm.appendButton(
+            "下一页"_trl(localeCode),
+            "textures/ui/arrowRight",
+            "path",
+            [open, page = mPage + 1](Player& self) { open(self, page); }
+        );
+    }
+}
+
+
+} // namespace ltps
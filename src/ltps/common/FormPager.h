@@ -0,0 +1,46 @@
+#pragma once
+#include "ll/api/form/SimpleForm.h"
+#include "ltps/Global.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+
+class Player;
+
+namespace ltps {
+
+/**
+ * @brief 表单分页 (FormPager)
+ * 列表类表单只为当前页构建按钮，翻页时通过 open 回调重新构建目标页，
+ * 按钮回调只应保存名称等轻量句柄，点击时再从存储中取得记录。
+ * 页码超出范围 (例如翻页期间记录被删除) 时自动收敛到最后一页。
+ */
+class FormPager {
+public:
+    using OpenPage = std::function<void(Player& player, std::size_t page)>;
+
+    static constexpr std::size_t PAGE_SIZE = 20;
+
+private:
+    std::size_t mTotal;
+    std::size_t mPage;
+    std::size_t mPageSize;
+
+public:
+    TPSAPI explicit FormPager(std::size_t total, std::size_t page, std::size_t pageSize = PAGE_SIZE);
+
+    [[nodiscard]] std::size_t page() const { return mPage; }
+    [[nodiscard]] std::size_t pageCount() const { return mTotal == 0 ? 1 : (mTotal + mPageSize - 1) / mPageSize; }
+    [[nodiscard]] std::size_t begin() const { return mPage * mPageSize; }
+    [[nodiscard]] std::size_t end() const { return std::min(mTotal, begin() + mPageSize); }
+
+    // 页码说明, 如 "第 1/5 页"
+    TPSNDAPI std::string describe(std::string const& localeCode) const;
+
+    // 按需追加 "上一页" / "下一页" 按钮
+    TPSAPI void appendButtons(ll::form::SimpleForm& fm, std::string const& localeCode, OpenPage const& open) const;
+};
+
+} // namespace ltps
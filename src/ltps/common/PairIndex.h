@@ -0,0 +1,214 @@
+#pragma once
+#include "ltps/common/FlatHashMap.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 有序对索引（PairIndex）
+ * 以 (first, second) 有序对为键保存值，例如 (发起者, 接收者) -> 请求：
+ *  - 节点存放在连续的节点数组中并复用空闲节点，有序对到节点下标的映射为开放寻址哈希表，按对查找只需一次探测
+ *  - 每个节点同时挂在 first 与 second 两条侵入式双向链表上，按任一端遍历或整体移除某个 ID 的所有条目
+ *    只访问该 ID 的节点，不扫描整个索引
+ *
+ * find 返回的指针在下一次插入 / 删除之前有效，链表遍历顺序为插入顺序的逆序。非线程安全，由调用方保证同步。
+ */
+template <typename Id, typename Value, typename IdHash = std::hash<Id>>
+class PairIndex {
+public:
+    struct Key {
+        Id first;
+        Id second;
+
+        bool operator==(Key const&) const = default;
+    };
+
+private:
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+
+    struct KeyHash {
+        [[no_unique_address]] IdHash mHash;
+
+        std::size_t operator()(Key const& key) const {
+            return static_cast<std::size_t>(
+                static_cast<std::uint64_t>(mHash(key.first)) * 0x9e3779b97f4a7c15ULL
+                ^ static_cast<std::uint64_t>(mHash(key.second))
+            );
+        }
+    };
+
+    struct Node {
+        Key           key{};
+        Value         value{};
+        std::uint32_t prevByFirst{NIL};
+        std::uint32_t nextByFirst{NIL};
+        std::uint32_t prevBySecond{NIL};
+        std::uint32_t nextBySecond{NIL};
+    };
+
+    using Link  = std::uint32_t Node::*;
+    using Heads = FlatHashMap<Id, std::uint32_t, IdHash>;
+
+    std::vector<Node>                        mNodes;
+    std::vector<std::uint32_t>               mFree;
+    FlatHashMap<Key, std::uint32_t, KeyHash> mIndex;    // 有序对 -> 节点下标
+    Heads                                    mByFirst;  // first -> 链表头
+    Heads                                    mBySecond; // second -> 链表头
+
+    void link(Heads& heads, Id const& id, std::uint32_t index, Link prev, Link next) {
+        auto  head = heads.try_emplace(id, NIL).first;
+        auto& node = mNodes[index];
+        node.*prev = NIL;
+        node.*next = *head;
+        if (*head != NIL) {
+            mNodes[*head].*prev = index;
+        }
+        *head = index;
+    }
+
+    void unlink(Heads& heads, Id const& id, std::uint32_t index, Link prev, Link next) {
+        auto& node = mNodes[index];
+        if (node.*prev != NIL) {
+            mNodes[node.*prev].*next = node.*next;
+        } else if (node.*next != NIL) {
+            *heads.find(id) = node.*next;
+        } else {
+            heads.erase(id); // 链表已空
+        }
+        if (node.*next != NIL) {
+            mNodes[node.*next].*prev = node.*prev;
+        }
+        node.*prev = node.*next = NIL;
+    }
+
+    Value remove(std::uint32_t index) {
+        auto& node = mNodes[index];
+        unlink(mByFirst, node.key.first, index, &Node::prevByFirst, &Node::nextByFirst);
+        unlink(mBySecond, node.key.second, index, &Node::prevBySecond, &Node::nextBySecond);
+        mIndex.erase(node.key);
+
+        auto value = std::exchange(node.value, Value{}); // 立即释放节点持有的资源
+        mFree.push_back(index);
+        return value;
+    }
+
+    template <typename Fn>
+    void forEachIn(Heads const& heads, Id const& id, Link next, Fn&& fn) const {
+        auto head = heads.find(id);
+        for (auto index = head ? *head : NIL; index != NIL; index = mNodes[index].*next) {
+            fn(mNodes[index].key, mNodes[index].value);
+        }
+    }
+
+    template <typename Fn>
+    std::size_t removeIn(Heads& heads, Id const& id, Link next, Fn& fn) {
+        std::size_t count = 0;
+        auto        head  = heads.find(id);
+        for (auto index = head ? *head : NIL; index != NIL; ++count) {
+            auto following = mNodes[index].*next;
+            auto key       = mNodes[index].key;
+            fn(key, remove(index));
+            index = following;
+        }
+        return count;
+    }
+
+public:
+    [[nodiscard]] std::size_t size() const { return mIndex.size(); }
+    [[nodiscard]] bool        empty() const { return mIndex.empty(); }
+
+    void reserve(std::size_t count) {
+        mNodes.reserve(count);
+        mIndex.reserve(count);
+    }
+
+    [[nodiscard]] Value* find(Id const& first, Id const& second) {
+        auto index = mIndex.find(Key{first, second});
+        return index ? &mNodes[*index].value : nullptr;
+    }
+
+    [[nodiscard]] Value const* find(Id const& first, Id const& second) const {
+        return const_cast<PairIndex*>(this)->find(first, second);
+    }
+
+    [[nodiscard]] bool contains(Id const& first, Id const& second) const { return find(first, second) != nullptr; }
+
+    // 有序对不存在时插入 value, 返回值的指针以及是否插入
+    std::pair<Value*, bool> try_emplace(Id const& first, Id const& second, Value value = Value{}) {
+        Key key{first, second};
+        if (auto index = mIndex.find(key)) {
+            return {&mNodes[*index].value, false};
+        }
+
+        std::uint32_t index;
+        if (!mFree.empty()) {
+            index = mFree.back();
+            mFree.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(mNodes.size());
+            mNodes.emplace_back();
+        }
+        auto& node = mNodes[index];
+        node.key   = key;
+        node.value = std::move(value);
+        mIndex.try_emplace(key, index);
+        link(mByFirst, first, index, &Node::prevByFirst, &Node::nextByFirst);
+        link(mBySecond, second, index, &Node::prevBySecond, &Node::nextBySecond);
+        return {&node.value, true};
+    }
+
+    // 移除有序对并返回其值, 不存在时返回 std::nullopt
+    std::optional<Value> extract(Id const& first, Id const& second) {
+        auto index = mIndex.find(Key{first, second});
+        if (!index) {
+            return std::nullopt;
+        }
+        return remove(*index);
+    }
+
+    bool erase(Id const& first, Id const& second) { return extract(first, second).has_value(); }
+
+    // fn(second, value), 遍历 first 为 id 的所有条目
+    template <typename Fn>
+    void forEachByFirst(Id const& id, Fn&& fn) const {
+        forEachIn(mByFirst, id, &Node::nextByFirst, [&](Key const& key, Value const& value) { fn(key.second, value); });
+    }
+
+    // fn(first, value), 遍历 second 为 id 的所有条目
+    template <typename Fn>
+    void forEachBySecond(Id const& id, Fn&& fn) const {
+        forEachIn(mBySecond, id, &Node::nextBySecond, [&](Key const& key, Value const& value) {
+            fn(key.first, value);
+        });
+    }
+
+    // fn(key, value), 遍历所有条目
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        mIndex.forEach([&](Key const& key, std::uint32_t index) { fn(key, mNodes[index].value); });
+    }
+
+    // 移除 first 或 second 为 id 的所有条目, 每个条目移除后调用 fn(key, value), 返回移除数量
+    template <typename Fn>
+    std::size_t eraseById(Id const& id, Fn&& fn) {
+        auto count  = removeIn(mByFirst, id, &Node::nextByFirst, fn);
+        count      += removeIn(mBySecond, id, &Node::nextBySecond, fn);
+        return count;
+    }
+
+    void clear() {
+        mNodes.clear();
+        mFree.clear();
+        mIndex.clear();
+        mByFirst.clear();
+        mBySecond.clear();
+    }
+};
+
+} // namespace ltps
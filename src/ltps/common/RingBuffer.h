@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 定长环形缓冲区（RingBuffer），按从新到旧的顺序访问
+ * 存储空间在构造 / resize 时一次分配，push_front 在已满时覆盖最旧的元素，不移动其它元素。
+ * 下标 0 为最新的元素，operator[] 为 O(1)。
+ *
+ * 非线程安全，由调用方保证同步。
+ */
+template <typename T>
+class RingBuffer {
+    std::vector<T> mData;    // 容量固定为 mData.size()
+    std::size_t    mHead{0}; // 最新元素所在位置
+    std::size_t    mSize{0};
+
+    [[nodiscard]] std::size_t slotOf(std::size_t index) const { return (mHead + index) % mData.size(); }
+
+public:
+    class const_iterator {
+        RingBuffer const* mOwner{nullptr};
+        std::size_t       mIndex{0};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T const*;
+        using reference         = T const&;
+
+        const_iterator() = default;
+        const_iterator(RingBuffer const* owner, std::size_t index) : mOwner(owner), mIndex(index) {}
+
+        reference operator*() const { return (*mOwner)[mIndex]; }
+        pointer   operator->() const { return &(*mOwner)[mIndex]; }
+
+        const_iterator& operator++() {
+            ++mIndex;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            auto copy = *this;
+            ++mIndex;
+            return copy;
+        }
+
+        bool operator==(const_iterator const& other) const { return mIndex == other.mIndex; }
+    };
+
+    explicit RingBuffer(std::size_t capacity = 0) : mData(capacity) {}
+
+    [[nodiscard]] std::size_t size() const { return mSize; }
+    [[nodiscard]] std::size_t capacity() const { return mData.size(); }
+    [[nodiscard]] bool        empty() const { return mSize == 0; }
+    [[nodiscard]] bool        full() const { return mSize == mData.size(); }
+
+    [[nodiscard]] T const& operator[](std::size_t index) const { return mData[slotOf(index)]; }
+
+    [[nodiscard]] T const& at(std::size_t index) const {
+        if (index >= mSize) {
+            throw std::out_of_range("RingBuffer index out of range");
+        }
+        return (*this)[index];
+    }
+
+    [[nodiscard]] T const& front() const { return (*this)[0]; }
+    [[nodiscard]] T const& back() const { return (*this)[mSize - 1]; }
+
+    [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+    [[nodiscard]] const_iterator end() const { return {this, mSize}; }
+
+    // 插入为最新的元素, 已满时覆盖最旧的元素; 容量为 0 时忽略
+    void push_front(T value) {
+        if (mData.empty()) {
+            return;
+        }
+        mHead        = (mHead + mData.size() - 1) % mData.size();
+        mData[mHead] = std::move(value);
+        if (mSize < mData.size()) {
+            ++mSize;
+        }
+    }
+
+    // 追加为最旧的元素 (按从新到旧的顺序加载时使用), 已满时丢弃并返回 false
+    bool push_back(T value) {
+        if (full()) {
+            return false;
+        }
+        mData[slotOf(mSize)] = std::move(value);
+        ++mSize;
+        return true;
+    }
+
+    // 删除最旧的元素
+    void pop_back() {
+        if (mSize > 0) {
+            --mSize;
+        }
+    }
+
+    void clear() {
+        mHead = 0;
+        mSize = 0;
+    }
+
+    // 修改容量, 保留最新的 min(size, capacity) 个元素
+    void resize(std::size_t capacity) {
+        if (capacity == mData.size()) {
+            return;
+        }
+        std::vector<T> data(capacity);
+        auto           kept = std::min(mSize, capacity);
+        for (std::size_t i = 0; i < kept; ++i) {
+            data[i] = std::move(mData[slotOf(i)]);
+        }
+        mData = std::move(data);
+        mHead = 0;
+        mSize = kept;
+    }
+};
+
+} // namespace ltps
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 带代数校验的槽位表（SlotMap）
+ * insert 返回 Handle{槽位下标, 代数}，erase 后槽位的代数递增并放入空闲列表复用，
+ * 因此已删除记录的旧句柄不会解析到复用该槽位的新记录上。
+ *
+ * get 返回的指针在下一次 insert / erase / clear 之前有效 (insert 可能使槽位数组扩容)，
+ * 需要跨越修改时应保存句柄并重新 get。非线程安全，由调用方保证同步。
+ */
+template <typename T>
+class SlotMap {
+public:
+    struct Handle {
+        std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+        std::uint32_t generation{0};
+
+        bool operator==(Handle const&) const = default;
+    };
+
+private:
+    struct Slot {
+        std::optional<T> value;
+        std::uint32_t    generation{0};
+    };
+
+    std::vector<Slot>          mSlots;
+    std::vector<std::uint32_t> mFree;
+    std::size_t                mSize{0};
+
+public:
+    [[nodiscard]] std::size_t size() const { return mSize; }
+    [[nodiscard]] bool        empty() const { return mSize == 0; }
+
+    Handle insert(T value) {
+        std::uint32_t index;
+        if (!mFree.empty()) {
+            index = mFree.back();
+            mFree.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(mSlots.size());
+            mSlots.emplace_back();
+        }
+        auto& slot = mSlots[index];
+        slot.value.emplace(std::move(value));
+        ++mSize;
+        return Handle{index, slot.generation};
+    }
+
+    bool erase(Handle handle) {
+        if (!get(handle)) {
+            return false;
+        }
+        auto& slot = mSlots[handle.index];
+        slot.value.reset();
+        ++slot.generation;
+        mFree.push_back(handle.index);
+        --mSize;
+        return true;
+    }
+
+    [[nodiscard]] T* get(Handle handle) {
+        if (handle.index >= mSlots.size()) {
+            return nullptr;
+        }
+        auto& slot = mSlots[handle.index];
+        return slot.generation == handle.generation && slot.value ? &*slot.value : nullptr;
+    }
+
+    [[nodiscard]] T const* get(Handle handle) const { return const_cast<SlotMap*>(this)->get(handle); }
+
+    [[nodiscard]] bool contains(Handle handle) const { return get(handle) != nullptr; }
+
+    // 删除所有记录, 保留槽位的代数使旧句柄全部失效
+    void clear() {
+        mFree.clear();
+        for (std::uint32_t i = 0; i < mSlots.size(); ++i) {
+            if (mSlots[i].value) {
+                mSlots[i].value.reset();
+                ++mSlots[i].generation;
+            }
+            mFree.push_back(i);
+        }
+        mSize = 0;
+    }
+};
+
+} // namespace ltps
@@ -0,0 +1,217 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 按维度划分的网格空间索引（SpatialGrid）
+ * 每个维度在 XZ 平面上划分为边长 cellSize 的正方形格子，格子以哈希表稀疏存储，只保存有点的格子。
+ * 距离按三维欧氏距离计算，格子只用于剪枝 (水平距离不超过三维距离)。
+ *
+ *  - nearest:      从查询点所在格子逐圈向外扩展，第 r 圈之外的点距离至少为 r * cellSize，
+ *                  已找到 limit 个更近的点时即可停止；圈内格子数超过该维度已占用格子数时改为全量扫描
+ *  - withinRadius: 遍历半径覆盖的格子 (覆盖的格子多于已占用格子时遍历所有已占用格子)
+ *
+ * 非线程安全，由调用方保证同步。
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class SpatialGrid {
+public:
+    struct Hit {
+        Key   key;
+        float distance;
+    };
+
+private:
+    struct Point {
+        Key   key;
+        float x, y, z;
+    };
+    struct Location {
+        int           dimid;
+        std::uint64_t cell;
+    };
+    using Cells = std::unordered_map<std::uint64_t, std::vector<Point>>;
+
+    float                                   mCellSize;
+    std::unordered_map<int, Cells>          mDimensions; // 维度 -> 已占用的格子
+    std::unordered_map<Key, Location, Hash> mLocations;  // key -> 所在格子, 用于更新与删除
+
+    [[nodiscard]] std::int64_t toCell(float value) const {
+        return static_cast<std::int64_t>(std::floor(static_cast<double>(value) / mCellSize));
+    }
+
+    static std::uint64_t packCell(std::int64_t cx, std::int64_t cz) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32)
+             | static_cast<std::uint64_t>(static_cast<std::uint32_t>(cz));
+    }
+
+    static float distanceOf(Point const& point, float x, float y, float z) {
+        auto dx = point.x - x, dy = point.y - y, dz = point.z - z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    static void collect(std::vector<Point> const& points, float x, float y, float z, float max, std::vector<Hit>& out) {
+        for (auto const& point : points) {
+            if (auto distance = distanceOf(point, x, y, z); distance <= max) {
+                out.push_back({point.key, distance});
+            }
+        }
+    }
+
+    static void collectAll(Cells const& cells, float x, float y, float z, float max, std::vector<Hit>& out) {
+        for (auto const& [_, points] : cells) {
+            collect(points, x, y, z, max, out);
+        }
+    }
+
+    static void sortHits(std::vector<Hit>& hits, std::size_t limit) {
+        auto less = [](Hit const& lhs, Hit const& rhs) { return lhs.distance < rhs.distance; };
+        if (hits.size() > limit) {
+            std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(limit), hits.end(), less);
+            hits.resize(limit);
+        } else {
+            std::sort(hits.begin(), hits.end(), less);
+        }
+    }
+
+public:
+    explicit SpatialGrid(float cellSize = 64.0f) : mCellSize(cellSize) {}
+
+    [[nodiscard]] std::size_t size() const { return mLocations.size(); }
+    [[nodiscard]] bool        contains(Key const& key) const { return mLocations.contains(key); }
+
+    void clear() {
+        mDimensions.clear();
+        mLocations.clear();
+    }
+
+    // 插入点, key 已存在时更新其位置
+    void insert(Key const& key, int dimid, float x, float y, float z) {
+        erase(key);
+        auto cell = packCell(toCell(x), toCell(z));
+        mDimensions[dimid][cell].push_back({key, x, y, z});
+        mLocations.emplace(key, Location{dimid, cell});
+    }
+
+    bool erase(Key const& key) {
+        auto iter = mLocations.find(key);
+        if (iter == mLocations.end()) {
+            return false;
+        }
+        auto [dimid, cell] = iter->second;
+        mLocations.erase(iter);
+
+        auto& cells  = mDimensions[dimid];
+        auto& points = cells[cell];
+        auto  pos    = std::find_if(points.begin(), points.end(), [&](Point const& p) { return p.key == key; });
+        if (pos != points.end()) {
+            *pos = std::move(points.back()); // 格子内无序, 与末尾交换后删除
+            points.pop_back();
+        }
+        if (points.empty()) {
+            cells.erase(cell);
+        }
+        if (cells.empty()) {
+            mDimensions.erase(dimid);
+        }
+        return true;
+    }
+
+    // 距离最近的至多 limit 个点 (不超过 maxDistance), 按距离升序
+    [[nodiscard]] std::vector<Hit> nearest(
+        int         dimid,
+        float       x,
+        float       y,
+        float       z,
+        std::size_t limit,
+        float       maxDistance = std::numeric_limits<float>::infinity()
+    ) const {
+        std::vector<Hit> hits;
+        auto             dim = mDimensions.find(dimid);
+        if (dim == mDimensions.end() || limit == 0) {
+            return hits;
+        }
+        auto const& cells = dim->second;
+        auto        cx    = toCell(x);
+        auto        cz    = toCell(z);
+
+        for (std::int64_t r = 0;; ++r) {
+            if (static_cast<std::size_t>(r) * 8 > cells.size()) {
+                hits.clear(); // 剩余的圈比已占用的格子还多, 直接全量扫描
+                collectAll(cells, x, y, z, maxDistance, hits);
+                break;
+            }
+            auto visit = [&](std::int64_t gx, std::int64_t gz) {
+                if (auto iter = cells.find(packCell(gx, gz)); iter != cells.end()) {
+                    collect(iter->second, x, y, z, maxDistance, hits);
+                }
+            };
+            if (r == 0) {
+                visit(cx, cz);
+            } else {
+                for (auto gx = cx - r; gx <= cx + r; ++gx) {
+                    visit(gx, cz - r);
+                    visit(gx, cz + r);
+                }
+                for (auto gz = cz - r + 1; gz <= cz + r - 1; ++gz) {
+                    visit(cx - r, gz);
+                    visit(cx + r, gz);
+                }
+            }
+
+            auto bound = static_cast<float>(r) * mCellSize; // 尚未访问的点至少这么远
+            if (bound > maxDistance) {
+                break;
+            }
+            if (hits.size() >= limit) {
+                auto kth = hits.begin() + static_cast<std::ptrdiff_t>(limit - 1);
+                std::nth_element(hits.begin(), kth, hits.end(), [](Hit const& lhs, Hit const& rhs) {
+                    return lhs.distance < rhs.distance;
+                });
+                if (kth->distance <= bound) {
+                    break;
+                }
+            }
+        }
+        sortHits(hits, limit);
+        return hits;
+    }
+
+    // 半径内的所有点, 按距离升序
+    [[nodiscard]] std::vector<Hit> withinRadius(int dimid, float x, float y, float z, float radius) const {
+        std::vector<Hit> hits;
+        auto             dim = mDimensions.find(dimid);
+        if (dim == mDimensions.end() || !(radius >= 0)) {
+            return hits;
+        }
+        auto const& cells = dim->second;
+        auto        minX = toCell(x - radius), maxX = toCell(x + radius);
+        auto        minZ = toCell(z - radius), maxZ = toCell(z + radius);
+
+        auto span = static_cast<double>(maxX - minX + 1) * static_cast<double>(maxZ - minZ + 1);
+        if (!std::isfinite(radius) || span > static_cast<double>(cells.size())) {
+            collectAll(cells, x, y, z, radius, hits);
+        } else {
+            for (auto gx = minX; gx <= maxX; ++gx) {
+                for (auto gz = minZ; gz <= maxZ; ++gz) {
+                    if (auto iter = cells.find(packCell(gx, gz)); iter != cells.end()) {
+                        collect(iter->second, x, y, z, radius, hits);
+                    }
+                }
+            }
+        }
+        sortHits(hits, hits.size());
+        return hits;
+    }
+};
+
+} // namespace ltps
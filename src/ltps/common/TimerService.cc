@@ -0,0 +1,299 @@
+#include "ltps/common/TimerService.h"
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/common/BlockPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+
+namespace ltps {
+
+namespace {
+
+// 游戏刻时间轮中第 tick 刻对应的时间点
+TimerService::TimePoint tickPoint(std::uint64_t tick) {
+    return TimerService::TimePoint{} + TimerService::Duration{static_cast<TimerService::Duration::rep>(tick)};
+}
+
+} // namespace
+
+
+struct TimerService::Timer {
+    TimerId                       id;
+    TimePoint                     deadline;
+    Duration                      interval; // 0 表示一次性定时器
+    Callback                      callback;
+    Dispatch                      dispatch;
+    TimingWheel<TimerPtr>::Handle handle;
+    std::atomic_bool              cancelled{false}; // 一次性定时器开始执行时也会置位, 与 cancel() 先到者生效
+    std::atomic_bool              running{false};   // 已派发但尚未执行完
+    bool                          fired{false};     // 一次性定时器已派发, 受 mMutex 保护
+    bool                          gameTick{false};  // 截止时间与周期以游戏刻计, 位于 mTickWheel
+};
+
+
+TimerService::TimerService(ll::thread::ThreadPoolExecutor& threadPool, Duration tick)
+: mThreadPool(threadPool),
+  mWheel(tick),
+  mTickWheel(Duration{1}, TimePoint{}) {
+    mWorker = std::thread([this] { workerLoop(); });
+    startTickHook();
+}
+
+TimerService::~TimerService() {
+    mTickAbortFlag->store(true);
+    {
+        std::lock_guard lock{mMutex};
+        mAbort = true;
+    }
+    mCv.notify_all();
+    if (mWorker.joinable()) {
+        mWorker.join();
+    }
+
+    // 已派发到其它线程的回调持有 Timer, 标记取消后由其自行跳过
+    mDispatched.clear();
+    mTimers.forEach([](TimerId, TimerPtr const& timer) { timer->cancelled.store(true); });
+    mTimers.clear();
+    mWheel.clear();
+    mTickWheel.clear();
+}
+
+
+TimerService::TimerId
+TimerService::add(TimePoint deadline, Duration interval, Callback callback, Dispatch dispatch, bool gameTick) {
+    auto timer      = std::allocate_shared<Timer>(PoolAllocator<Timer>{}); // 定时器与控制块复用池化内存
+    timer->deadline = deadline;
+    timer->interval = interval;
+    timer->callback = std::move(callback);
+    timer->dispatch = dispatch;
+    timer->gameTick = gameTick;
+    {
+        std::lock_guard lock{mMutex};
+        pruneDispatched();
+        timer->id     = mNextId++;
+        timer->handle = wheelOf(*timer).insert(deadline, timer);
+        mTimers.try_emplace(timer->id, timer);
+    }
+    if (!gameTick) {
+        mCv.notify_all(); // 新的截止时间可能早于工作线程当前的等待时间
+    }
+    return timer->id;
+}
+
+TimingWheel<TimerService::TimerPtr>& TimerService::wheelOf(Timer const& timer) {
+    return timer.gameTick ? mTickWheel : mWheel;
+}
+
+TimerService::TimerId TimerService::scheduleAt(TimePoint deadline, Callback callback, Dispatch dispatch) {
+    return add(deadline, Duration::zero(), std::move(callback), dispatch);
+}
+
+TimerService::TimerId
+TimerService::scheduleAt(std::chrono::system_clock::time_point deadline, Callback callback, Dispatch dispatch) {
+    auto delay = std::chrono::duration_cast<Duration>(deadline - std::chrono::system_clock::now());
+    return scheduleAfter(delay, std::move(callback), dispatch);
+}
+
+TimerService::TimerId TimerService::scheduleAfter(Duration delay, Callback callback, Dispatch dispatch) {
+    return add(Clock::now() + delay, Duration::zero(), std::move(callback), dispatch);
+}
+
+TimerService::TimerId TimerService::scheduleEvery(Duration interval, Callback callback, Dispatch dispatch) {
+    interval = std::max(interval, mWheel.tick());
+    return add(Clock::now() + interval, interval, std::move(callback), dispatch);
+}
+
+TimerService::TimerId TimerService::scheduleAfterTicks(ll::chrono::ticks delay, Callback callback) {
+    auto ticks = static_cast<std::uint64_t>(std::max<std::int64_t>(delay.count(), 1));
+    return add(tickPoint(mGameTick.load() + ticks), Duration::zero(), std::move(callback), Dispatch::Worker, true);
+}
+
+TimerService::TimerId TimerService::scheduleEveryTicks(ll::chrono::ticks interval, Callback callback) {
+    auto ticks    = static_cast<std::uint64_t>(std::max<std::int64_t>(interval.count(), 1));
+    auto deadline = tickPoint(mGameTick.load() + ticks);
+    return add(deadline, tickPoint(ticks) - TimePoint{}, std::move(callback), Dispatch::Worker, true);
+}
+
+bool TimerService::cancel(TimerId id) {
+    std::lock_guard lock{mMutex};
+    auto            timer = mTimers.find(id);
+    if (!timer) {
+        return false;
+    }
+    // 已派发的一次性定时器仍在 mTimers 中, 回调开始前置位即可阻止执行
+    bool pending = !(*timer)->cancelled.exchange(true);
+    wheelOf(**timer).cancel((*timer)->handle); // 立即释放回调持有的资源
+    mTimers.erase(id);
+    return pending;
+}
+
+bool TimerService::trigger(TimerId id) {
+    TimerPtr timer;
+    {
+        std::lock_guard lock{mMutex};
+        auto            found = mTimers.find(id);
+        if (!found || (*found)->fired) {
+            return false;
+        }
+        timer = *found;
+        if (timer->interval == Duration::zero()) {
+            timer->fired = true;
+            wheelOf(*timer).cancel(timer->handle);
+            mDispatched.push_back(timer);
+        }
+    }
+    dispatch(timer);
+    return true;
+}
+
+bool TimerService::contains(TimerId id) const {
+    std::lock_guard lock{mMutex};
+    auto            timer = mTimers.find(id);
+    return timer && !(*timer)->cancelled.load();
+}
+
+std::size_t TimerService::size() const {
+    std::lock_guard lock{mMutex};
+    return mTimers.size();
+}
+
+
+void TimerService::dispatch(TimerPtr const& timer) {
+    if (timer->running.exchange(true)) {
+        return; // 上一次派发尚未执行完
+    }
+    auto run = [timer] {
+        // 一次性定时器在此与 cancel() 争抢同一标志, 置位后 cancel() 返回 false, 且之后可从 mTimers 中移除
+        bool oneShot   = timer->interval == Duration::zero();
+        bool cancelled = oneShot ? timer->cancelled.exchange(true) : timer->cancelled.load();
+        if (!cancelled) {
+            try {
+                timer->callback();
+            } catch (const std::exception& e) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "TimerService: Timer {} callback failed: {}",
+                    timer->id,
+                    e.what()
+                );
+            } catch (...) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "TimerService: Timer {} callback failed: unknown error",
+                    timer->id
+                );
+            }
+        }
+        if (oneShot) {
+            timer->callback = nullptr; // 只会派发一次, 立即释放回调持有的资源
+        }
+        timer->running.store(false);
+    };
+
+    switch (timer->dispatch) {
+    case Dispatch::Worker:
+        run();
+        break;
+    case Dispatch::ServerThread:
+        ll::coro::keepThis([run = std::move(run)]() -> ll::coro::CoroTask<> {
+            run();
+            co_return;
+        }).launch(ll::thread::ServerThreadExecutor::getDefault());
+        break;
+    case Dispatch::ThreadPool:
+        ll::coro::keepThis([run = std::move(run)]() -> ll::coro::CoroTask<> {
+            run();
+            co_return;
+        }).launch(mThreadPool);
+        break;
+    }
+}
+
+void TimerService::collect(TimingWheel<TimerPtr>& wheel, TimePoint now, std::vector<TimerPtr>& expired) {
+    wheel.advance(now, expired);
+    for (auto& timer : expired) {
+        if (timer->interval > Duration::zero()) {
+            // 按固定频率排下一次, 落后超过一个周期时从当前时间重新计算
+            timer->deadline = std::max(timer->deadline + timer->interval, now);
+            timer->handle   = wheel.insert(timer->deadline, timer);
+        } else {
+            timer->fired = true; // 保留在 mTimers 中直到回调结束, 以便仍可取消
+            mDispatched.push_back(timer);
+        }
+    }
+}
+
+void TimerService::startTickHook() {
+    mTickAbortFlag = std::make_shared<std::atomic_bool>(false);
+    ll::coro::keepThis([this, abortFlag = mTickAbortFlag]() -> ll::coro::CoroTask<> {
+        std::vector<TimerPtr> expired;
+        while (!abortFlag->load()) {
+            co_await ll::chrono::ticks(1);
+            if (abortFlag->load()) {
+                break;
+            }
+            advanceGameTick(expired);
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
+void TimerService::advanceGameTick(std::vector<TimerPtr>& expired) {
+    auto now = tickPoint(mGameTick.fetch_add(1) + 1);
+    {
+        std::lock_guard lock{mMutex};
+        pruneDispatched();
+        collect(mTickWheel, now, expired); // 没有定时器时时间轮直接跳到 now
+    }
+    for (auto& timer : expired) {
+        dispatch(timer); // Dispatch::Worker: 直接在推进时间轮的服务器线程执行
+    }
+    expired.clear();
+}
+
+void TimerService::pruneDispatched() {
+    std::erase_if(mDispatched, [this](TimerPtr const& timer) {
+        if (!timer->cancelled.load()) {
+            return false; // 回调尚未开始, 仍可取消
+        }
+        mTimers.erase(timer->id);
+        return true;
+    });
+}
+
+void TimerService::workerLoop() {
+    std::unique_lock      lock{mMutex};
+    std::vector<TimerPtr> expired;
+
+    while (!mAbort) {
+        pruneDispatched();
+        auto wakeup = mWheel.nextWakeup();
+        if (!wakeup) {
+            mCv.wait(lock, [this] { return mAbort || !mWheel.empty(); });
+            continue;
+        }
+        if (*wakeup > Clock::now()) {
+            mCv.wait_until(lock, *wakeup); // 登记新定时器会唤醒以便重新计算
+            continue;
+        }
+
+        collect(mWheel, Clock::now(), expired);
+        if (expired.empty()) {
+            continue; // 只做了级联
+        }
+
+        lock.unlock();
+        for (auto& timer : expired) {
+            dispatch(timer);
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
+
+
+} // namespace ltps
@@ -0,0 +1,124 @@
+#pragma once
+#include "ll/api/chrono/GameChrono.h"
+#include "ll/api/thread/ThreadPoolExecutor.h"
+#include "ltps/Global.h"
+#include "ltps/common/FlatHashMap.h"
+#include "ltps/common/TimingWheel.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace ltps {
+
+/**
+ * @brief 共享定时器服务（TimerService）
+ * 由 TeleportSystem 持有，各模块在此登记截止时间，所有定时器共用一个分层时间轮与一个工作线程，
+ * 工作线程只在最近的截止时间 (或时间轮级联边界) 醒来，没有定时器时一直休眠。
+ *  - 截止时间可以是 steady_clock 时间点、时长或 system_clock 墙上时间，由工作线程按墙上时间推进
+ *  - 也可以按游戏刻登记 (scheduleAfterTicks / scheduleEveryTicks)：截止时间以游戏刻计，存放在单独的时间轮中，
+ *    由服务器线程每刻推进一次，回调在服务器线程执行；服务器卡顿时随实际游戏刻推迟，不按 50ms 换算
+ *  - 回调可在工作线程、服务器线程或插件线程池中执行，工作线程上的回调须足够轻量
+ *  - 取消后回调不会再开始执行，已开始执行的回调不受影响；一次性定时器触发后、回调开始前仍可取消
+ */
+class TimerService final {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+    using TimerId   = std::uint64_t;
+    using Callback  = std::function<void()>;
+
+    static constexpr TimerId InvalidTimer = 0;
+
+    enum class Dispatch {
+        Worker,       // 定时器工作线程, 仅用于轻量回调
+        ServerThread, // 服务器线程, 可以访问游戏对象
+        ThreadPool,   // 插件线程池, 用于数据库读写等耗时操作
+    };
+
+private:
+    struct Timer;
+    using TimerPtr = std::shared_ptr<Timer>;
+
+    ll::thread::ThreadPoolExecutor& mThreadPool;
+    TimingWheel<TimerPtr>             mWheel;
+    TimingWheel<TimerPtr>             mTickWheel;   // 游戏刻时间轮, 原点 TimePoint{}, 每个 Duration{1} 为一刻
+    std::atomic<std::uint64_t>        mGameTick{0}; // 已推进的游戏刻数, 只由服务器线程递增
+    std::shared_ptr<std::atomic_bool> mTickAbortFlag;
+    FlatHashMap<TimerId, TimerPtr>    mTimers;     // 未触发的定时器与已派发但回调尚未开始的一次性定时器
+    std::vector<TimerPtr>             mDispatched; // 已派发的一次性定时器, 回调开始或取消后从 mTimers 中移除
+    TimerId                           mNextId{1};
+    mutable std::mutex                mMutex;
+    std::condition_variable           mCv;
+    bool                              mAbort{false};
+    std::thread                       mWorker;
+
+    TimerId add(TimePoint deadline, Duration interval, Callback callback, Dispatch dispatch, bool gameTick = false);
+
+    TimingWheel<TimerPtr>& wheelOf(Timer const& timer);
+
+    // 推进 wheel 到 now, 到期的定时器移入 expired, 周期定时器排下一次; 调用方须持有 mMutex
+    void collect(TimingWheel<TimerPtr>& wheel, TimePoint now, std::vector<TimerPtr>& expired);
+
+    void dispatch(TimerPtr const& timer);
+
+    void startTickHook(); // 在服务器线程每刻推进一次游戏刻时间轮
+
+    void advanceGameTick(std::vector<TimerPtr>& expired);
+
+    // 移除回调已开始或已取消的一次性定时器, 调用方须持有 mMutex
+    void pruneDispatched();
+
+    void workerLoop();
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(TimerService);
+
+    TPSAPI explicit TimerService(
+        ll::thread::ThreadPoolExecutor& threadPool,
+        Duration                        tick = std::chrono::milliseconds{50}
+    );
+    TPSAPI ~TimerService();
+
+    // 在 deadline 执行一次
+    TPSAPI TimerId scheduleAt(TimePoint deadline, Callback callback, Dispatch dispatch = Dispatch::ServerThread);
+
+    // 在墙上时间 deadline 执行一次, 登记时按当前系统时间换算
+    TPSAPI TimerId scheduleAt(
+        std::chrono::system_clock::time_point deadline,
+        Callback                              callback,
+        Dispatch                              dispatch = Dispatch::ServerThread
+    );
+
+    // delay 之后执行一次
+    TPSAPI TimerId scheduleAfter(Duration delay, Callback callback, Dispatch dispatch = Dispatch::ServerThread);
+
+    // 每隔 interval 执行一次, 上一次派发的回调尚未执行完时跳过本次
+    TPSAPI TimerId scheduleEvery(Duration interval, Callback callback, Dispatch dispatch = Dispatch::ServerThread);
+
+    // delay 个游戏刻之后在服务器线程执行一次
+    TPSAPI TimerId scheduleAfterTicks(ll::chrono::ticks delay, Callback callback);
+
+    // 每隔 interval 个游戏刻在服务器线程执行一次
+    TPSAPI TimerId scheduleEveryTicks(ll::chrono::ticks interval, Callback callback);
+
+    // 取消定时器, 回调已开始执行的一次性定时器或无效 ID 返回 false
+    TPSAPI bool cancel(TimerId id);
+
+    // 立即派发一次, 不改变周期定时器的下一次截止时间; 一次性定时器视为提前触发
+    TPSAPI bool trigger(TimerId id);
+
+    TPSNDAPI bool contains(TimerId id) const;
+
+    TPSNDAPI std::size_t size() const;
+};
+
+} // namespace ltps
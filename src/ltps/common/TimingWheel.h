@@ -0,0 +1,238 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ltps {
+
+/**
+ * @brief 分层时间轮（TimingWheel）
+ * 时间按 tick 离散化，共 LEVELS 层，每层 SLOTS 个槽，第 l 层每个槽覆盖 SLOTS^l 个 tick：
+ *  - 插入时按剩余 tick 数选择层级，挂到对应槽的侵入式双向链表上，O(1)
+ *  - 取消时凭句柄从链表摘除并立即销毁 value，O(1)；句柄带代数校验，已触发或已取消的句柄再次取消无效
+ *  - advance 逐 tick 推进，每转完一圈把上一层对应槽中的定时器重新分配到下层 (cascade)
+ * 超出最大范围 (SLOTS^LEVELS 个 tick) 的定时器先挂在最高层，级联时重新计算。
+ *
+ * 到期时间向上取整到 tick，定时器不会提前触发。非线程安全，由调用方保证同步。
+ */
+template <typename T>
+class TimingWheel {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+
+    struct Handle {
+        std::uint32_t index{std::numeric_limits<std::uint32_t>::max()};
+        std::uint32_t generation{0};
+
+        bool operator==(Handle const&) const = default;
+    };
+
+    static constexpr std::uint32_t SLOT_BITS = 6;
+    static constexpr std::uint32_t SLOTS     = 1u << SLOT_BITS;
+    static constexpr std::uint32_t LEVELS    = 4;
+
+private:
+    static constexpr std::uint32_t NIL       = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr std::uint64_t MAX_SPAN  = std::uint64_t{1} << (SLOT_BITS * LEVELS); // 可直接定位的 tick 数
+
+    struct Node {
+        std::optional<T> value;
+        std::uint64_t    deadline{0}; // 到期 tick
+        std::uint32_t    prev{NIL};
+        std::uint32_t    next{NIL};
+        std::uint32_t    generation{0};
+        std::uint16_t    bucket{0}; // level * SLOTS + slot
+    };
+
+    Duration                                  mTick;
+    TimePoint                                 mOrigin;
+    std::uint64_t                             mCurrent{0}; // 下一个待处理的 tick
+    std::vector<Node>                         mNodes;
+    std::vector<std::uint32_t>                mFree;
+    std::array<std::uint32_t, LEVELS * SLOTS> mHeads;      // 每个槽的链表头
+    std::array<std::uint64_t, LEVELS>         mOccupied{}; // 每层非空槽的位图
+    std::size_t                               mSize{0};
+
+    [[nodiscard]] std::uint64_t toTick(TimePoint time, bool roundUp) const {
+        if (time <= mOrigin) {
+            return 0;
+        }
+        auto elapsed = (time - mOrigin).count();
+        auto tick    = mTick.count();
+        return static_cast<std::uint64_t>(roundUp ? (elapsed + tick - 1) / tick : elapsed / tick);
+    }
+
+    void link(std::uint32_t index) {
+        auto& node     = mNodes[index];
+        auto  deadline = std::max(node.deadline, mCurrent);
+        auto  delta    = std::min(deadline - mCurrent, MAX_SPAN - 1);
+        auto  target   = mCurrent + delta;
+
+        std::uint32_t level = 0;
+        while (level + 1 < LEVELS && delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        auto slot   = static_cast<std::uint32_t>((target >> (SLOT_BITS * level)) & SLOT_MASK);
+        auto bucket = level * SLOTS + slot;
+
+        node.bucket = static_cast<std::uint16_t>(bucket);
+        node.prev   = NIL;
+        node.next   = mHeads[bucket];
+        if (node.next != NIL) {
+            mNodes[node.next].prev = index;
+        }
+        mHeads[bucket] = index;
+
+        mOccupied[level] |= std::uint64_t{1} << slot;
+    }
+
+    void unlink(std::uint32_t index) {
+        auto& node = mNodes[index];
+        if (node.prev != NIL) {
+            mNodes[node.prev].next = node.next;
+        } else {
+            mHeads[node.bucket] = node.next;
+        }
+        if (node.next != NIL) {
+            mNodes[node.next].prev = node.prev;
+        }
+        if (mHeads[node.bucket] == NIL) {
+            mOccupied[node.bucket / SLOTS] &= ~(std::uint64_t{1} << (node.bucket % SLOTS));
+        }
+        node.prev = node.next = NIL;
+    }
+
+    void release(std::uint32_t index) {
+        auto& node = mNodes[index];
+        node.value.reset(); // 立即释放持有的资源
+        ++node.generation;
+        mFree.push_back(index);
+        --mSize;
+    }
+
+    // 取下整个槽的链表
+    std::uint32_t detach(std::uint32_t level, std::uint32_t slot) {
+        auto bucket    = level * SLOTS + slot;
+        auto head      = mHeads[bucket];
+        mHeads[bucket] = NIL;
+
+        mOccupied[level] &= ~(std::uint64_t{1} << slot);
+        return head;
+    }
+
+    // 把第 level 层当前槽中的定时器重新分配到下层
+    void cascade(std::uint32_t level) {
+        auto slot = static_cast<std::uint32_t>((mCurrent >> (SLOT_BITS * level)) & SLOT_MASK);
+        for (auto index = detach(level, slot); index != NIL;) {
+            auto next = mNodes[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+public:
+    explicit TimingWheel(Duration tick = std::chrono::milliseconds{50}, TimePoint origin = Clock::now())
+    : mTick(std::max(tick, Duration{1})),
+      mOrigin(origin) {
+        mHeads.fill(NIL);
+    }
+
+    [[nodiscard]] std::size_t size() const { return mSize; }
+    [[nodiscard]] bool        empty() const { return mSize == 0; }
+    [[nodiscard]] Duration    tick() const { return mTick; }
+
+    Handle insert(TimePoint deadline, T value) {
+        std::uint32_t index;
+        if (!mFree.empty()) {
+            index = mFree.back();
+            mFree.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(mNodes.size());
+            mNodes.emplace_back();
+        }
+        auto& node = mNodes[index];
+        node.value.emplace(std::move(value));
+        node.deadline = toTick(deadline, true);
+        link(index);
+        ++mSize;
+        return Handle{index, node.generation};
+    }
+
+    [[nodiscard]] bool contains(Handle handle) const {
+        return handle.index < mNodes.size() && mNodes[handle.index].generation == handle.generation
+            && mNodes[handle.index].value.has_value();
+    }
+
+    // 取消定时器并立即销毁 value, 句柄已失效 (已触发 / 已取消) 时返回 false
+    bool cancel(Handle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        unlink(handle.index);
+        release(handle.index);
+        return true;
+    }
+
+    // 推进到 now, 到期的 value 按到期顺序移入 expired
+    void advance(TimePoint now, std::vector<T>& expired) {
+        auto target = toTick(now, false);
+        while (mCurrent <= target) {
+            if (mSize == 0) {
+                mCurrent = target + 1; // 没有定时器, 直接跳过
+                break;
+            }
+            auto slot = static_cast<std::uint32_t>(mCurrent & SLOT_MASK);
+            if (slot == 0) {
+                // 从高层到低层级联, 保证本 tick 到期的定时器落入第 0 层当前槽
+                for (std::uint32_t level = LEVELS - 1; level > 0; --level) {
+                    if ((mCurrent & ((std::uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0) {
+                        cascade(level);
+                    }
+                }
+            }
+            for (auto index = detach(0, slot); index != NIL;) {
+                auto next = mNodes[index].next;
+                expired.push_back(std::move(*mNodes[index].value));
+                release(index);
+                index = next;
+            }
+            ++mCurrent;
+        }
+    }
+
+    // 下一次需要调用 advance 的时间 (可能早于实际到期时间, 此时只做级联), 没有定时器时返回 std::nullopt
+    [[nodiscard]] std::optional<TimePoint> nextWakeup() const {
+        if (mSize == 0) {
+            return std::nullopt;
+        }
+        auto slot     = static_cast<std::uint32_t>(mCurrent & SLOT_MASK);
+        auto boundary = (mCurrent | SLOT_MASK) + 1; // 下一次级联
+        auto next     = boundary;
+        if (auto ahead = mOccupied[0] >> slot; ahead != 0) {
+            next = mCurrent + static_cast<std::uint64_t>(std::countr_zero(ahead));
+        }
+        return mOrigin + mTick * static_cast<Duration::rep>(next);
+    }
+
+    void clear() {
+        for (std::uint32_t index = 0; index < mNodes.size(); ++index) {
+            if (mNodes[index].value) {
+                release(index);
+            }
+        }
+        mHeads.fill(NIL);
+        mOccupied.fill(0);
+    }
+};
+
+} // namespace ltps
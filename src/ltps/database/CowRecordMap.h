@@ -0,0 +1,137 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+
+namespace ltps {
+
+/**
+ * @brief 写时复制的记录表 (CowRecordMap)
+ * 每条记录都是不可变的 std::shared_ptr<T const>，修改时复制一份新记录再替换指针。
+ * 回写线程通过 takeDirtySnapshot() 拿到变更记录的指针后在锁外序列化，
+ * 服务器线程继续修改只会发布新版本，不会影响正在序列化的旧版本。
+ *
+ * 线程约定:
+ *  - 只有一个写线程 (服务器线程) 调用 set/erase/emplaceClean/clear，写线程读取无需加锁
+ *  - 其它线程只能调用 takeDirtySnapshot() / markDirty()
+ *  - mMutex 只保护指针替换与脏集合交换，持有时间与变更记录数量成正比
+ *  - 快照取出后到 commitSnapshot() / markDirty() 之前，其中的键处于"回写中"状态
+ */
+template <typename T, typename Key = std::string>
+class CowRecordMap {
+public:
+    using Record   = std::shared_ptr<T const>;
+    using Map      = std::unordered_map<Key, Record>;
+    using Snapshot = std::vector<std::pair<Key, Record>>; // Record 为空表示该记录已删除
+
+private:
+    Map                     mRecords;
+    std::unordered_set<Key> mDirtyKeys;
+    std::unordered_set<Key> mInFlightKeys; // 已取出快照但尚未确认写入的键
+    mutable std::mutex      mMutex;
+
+public:
+    CowRecordMap()                               = default;
+    CowRecordMap(CowRecordMap const&)            = delete;
+    CowRecordMap& operator=(CowRecordMap const&) = delete;
+
+    [[nodiscard]] T const* find(Key const& key) const {
+        auto iter = mRecords.find(key);
+        return iter == mRecords.end() ? nullptr : iter->second.get();
+    }
+
+    [[nodiscard]] Record get(Key const& key) const {
+        auto iter = mRecords.find(key);
+        return iter == mRecords.end() ? nullptr : iter->second;
+    }
+
+    [[nodiscard]] bool contains(Key const& key) const { return mRecords.contains(key); }
+
+    [[nodiscard]] std::size_t size() const { return mRecords.size(); }
+
+    [[nodiscard]] Map const& records() const { return mRecords; }
+
+    // 发布新版本并标记为脏
+    void set(Key const& key, T value) {
+        Record          record = std::make_shared<T>(std::move(value));
+        std::lock_guard lock{mMutex};
+        mRecords.insert_or_assign(key, std::move(record));
+        mDirtyKeys.insert(key);
+    }
+
+    // 删除记录并标记为脏
+    bool erase(Key const& key) {
+        std::lock_guard lock{mMutex};
+        if (mRecords.erase(key) == 0) {
+            return false;
+        }
+        mDirtyKeys.insert(key);
+        return true;
+    }
+
+    // 加载数据时使用，不标记为脏
+    void emplaceClean(Key key, T value) {
+        Record          record = std::make_shared<T>(std::move(value));
+        std::lock_guard lock{mMutex};
+        mRecords.insert_or_assign(std::move(key), std::move(record));
+    }
+
+    void clear() {
+        std::lock_guard lock{mMutex};
+        mRecords.clear();
+        mDirtyKeys.clear();
+        mInFlightKeys.clear();
+    }
+
+    // 是否存在尚未写入数据库的变更 (此时数据库中的值已过期)
+    [[nodiscard]] bool isPending(Key const& key) const {
+        std::lock_guard lock{mMutex};
+        return mDirtyKeys.contains(key) || mInFlightKeys.contains(key);
+    }
+
+    // 从内存中移除已落盘的记录，存在未写入的变更时返回 false
+    bool tryEvict(Key const& key) {
+        std::lock_guard lock{mMutex};
+        if (mDirtyKeys.contains(key) || mInFlightKeys.contains(key)) {
+            return false;
+        }
+        return mRecords.erase(key) != 0;
+    }
+
+    // 回写失败时把快照中的键重新标记为脏
+    void markDirty(Snapshot const& snapshot) {
+        std::lock_guard lock{mMutex};
+        for (auto const& [key, _] : snapshot) {
+            mDirtyKeys.insert(key);
+        }
+        mInFlightKeys.clear();
+    }
+
+    // 快照已全部写入数据库
+    void commitSnapshot() {
+        std::lock_guard lock{mMutex};
+        mInFlightKeys.clear();
+    }
+
+    // 取出自上次调用以来所有变更记录的当前版本
+    [[nodiscard]] Snapshot takeDirtySnapshot() {
+        Snapshot        snapshot;
+        std::lock_guard lock{mMutex};
+        snapshot.reserve(mDirtyKeys.size());
+        for (auto const& key : mDirtyKeys) {
+            auto iter = mRecords.find(key);
+            snapshot.emplace_back(key, iter == mRecords.end() ? nullptr : iter->second);
+        }
+        mInFlightKeys.merge(mDirtyKeys);
+        mDirtyKeys.clear();
+        return snapshot;
+    }
+};
+
+} // namespace ltps
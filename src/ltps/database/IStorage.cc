@@ -1,6 +1,11 @@
 #include "ltps/database/IStorage.h"
+#include "ll/api/coro/CoroTask.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/database/PlayerRegistry.h"
 #include "ltps/database/StorageManager.h"
+#include "nlohmann/json.hpp"
+#include <stdexcept>
 
 namespace ltps {
 
@@ -9,5 +14,98 @@ ll::data::KeyValueDB& IStorage::getDatabase() const {
     return *TeleportSystem::getInstance().getStorageManager().mDatabase;
 }
 
+PlayerRegistry& IStorage::getPlayerRegistry() {
+    return TeleportSystem::getInstance().getStorageManager().getPlayerRegistry();
+}
+
+std::optional<PlayerId> IStorage::findPlayerId(RealName const& realName, std::string_view key, bool lazy) const {
+    auto& registry = getPlayerRegistry();
+    if (auto id = registry.find(realName); id || !lazy || !getDatabase().has(key)) {
+        return id;
+    }
+    return registry.intern(realName);
+}
+
+void IStorage::markDirty() { mGeneration.fetch_add(1, std::memory_order_release); }
+
+void IStorage::journalSet(std::string_view key, std::string_view value) {
+    TeleportSystem::getInstance().getStorageManager().mJournal->append(StorageJournal::Op::Set, key, value);
+}
+void IStorage::journalDel(std::string_view key) {
+    TeleportSystem::getInstance().getStorageManager().mJournal->append(StorageJournal::Op::Del, key);
+}
+
+bool IStorage::isRecoveredFromJournal() {
+    return TeleportSystem::getInstance().getStorageManager().mJournalReplayed;
+}
+
+void IStorage::dispatchAsync(std::function<std::function<void()>()> task) {
+    ll::coro::keepThis([task = std::move(task)]() -> ll::coro::CoroTask<> {
+        std::function<void()> callback;
+        try {
+            callback = task();
+        } catch (const std::exception& e) {
+            TeleportSystem::getInstance().getSelf().getLogger().error("IStorage: Async task failed: {}", e.what());
+        }
+        if (callback) {
+            ll::coro::keepThis([callback = std::move(callback)]() -> ll::coro::CoroTask<> {
+                callback();
+                co_return;
+            }).launch(ll::thread::ServerThreadExecutor::getDefault());
+        }
+        co_return;
+    }).launch(TeleportSystem::getInstance().getThreadPool());
+}
+
+bool IStorage::isDirty() const { return mGeneration.load(std::memory_order_acquire) != mFlushedGeneration; }
+
+void IStorage::forEachWithPrefix(
+    std::string_view                                                         prefix,
+    std::function<void(std::string_view key, std::string_view value)> const& fn
+) const {
+    for (auto&& [key, value] : getDatabase().iter()) {
+        if (key.starts_with(prefix)) {
+            fn(key.substr(prefix.size()), value);
+        }
+    }
+}
+
+void IStorage::migrateLegacyObject(std::string_view legacyKey, std::string_view prefix) {
+    auto& db = getDatabase();
+
+    auto rawJson = db.get(legacyKey);
+    if (!rawJson.has_value()) {
+        return;
+    }
+
+    nlohmann::json json;
+    try {
+        json = nlohmann::json::parse(rawJson.value());
+    } catch (nlohmann::json::parse_error const& e) {
+        throw std::runtime_error("Could not parse legacy data of key: " + std::string{legacyKey});
+    }
+    if (!json.is_object()) {
+        throw std::runtime_error("Legacy data is not an object, key: " + std::string{legacyKey});
+    }
+
+    // 先写入新键，全部成功后再删除旧键，中途失败时下次启动会重新迁移
+    for (auto& [key, value] : json.items()) {
+        if (value.empty()) {
+            continue;
+        }
+        if (!db.set(std::string{prefix} + key, value.dump())) {
+            throw std::runtime_error("Could not migrate legacy data: " + key);
+        }
+    }
+    db.del(legacyKey);
+
+    TeleportSystem::getInstance().getSelf().getLogger().info(
+        "Migrated {} entries of legacy key \"{}\" to \"{}<key>\"",
+        json.size(),
+        legacyKey,
+        prefix
+    );
+}
+
 
-} // namespace ltps
\ No newline at end of file
+} // namespace ltps
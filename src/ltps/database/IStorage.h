@@ -1,23 +1,79 @@
 #pragma once
 #include "ll/api/data/KeyValueDB.h"
 #include "ltps/Global.h"
+#include "ltps/database/StorageBatch.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 
 namespace ltps {
 
+class PlayerRegistry;
+
 
 class IStorage {
     friend class StorageManager;
 
+    std::atomic<std::uint64_t> mGeneration{0};        // 变更计数，每次修改数据时递增
+    std::uint64_t              mFlushedGeneration{0}; // 上次成功回写时的变更计数
+
 protected:
     TPSNDAPI inline ll::data::KeyValueDB& getDatabase() const;
 
+    TPSNDAPI static PlayerRegistry& getPlayerRegistry();
+
+    // 查找玩家 ID, 只读查询不为无数据的玩家分配; 按需加载时数据库中可能有尚未注册的玩家 (旧版数据),
+    // 此时 lazy 为 true 且 key 存在才分配, 其余 ID 只在写入时分配
+    TPSNDAPI std::optional<PlayerId> findPlayerId(RealName const& realName, std::string_view key, bool lazy) const;
+
+    // 标记存储已变更，下次回写时才会写入数据库
+    TPSAPI void markDirty();
+
+    // 追加预写日志记录, 须在修改发布到内存之后调用
+    TPSAPI void journalSet(std::string_view key, std::string_view value);
+    TPSAPI void journalDel(std::string_view key);
+
+    // 本次启动是否重放过预写日志: 日志只记录各条记录, 由记录派生并随回写保存的数据 (如概要) 可能已过期
+    TPSNDAPI static bool isRecoveredFromJournal();
+
+    // 在线程池执行 task, 其返回的回调 (可为空) 随后在服务器线程执行, 用于按需加载时的异步预加载
+    TPSAPI static void dispatchAsync(std::function<std::function<void()>()> task);
+
+    // 遍历所有以 prefix 开头的键, 回调参数中的 key 已去除前缀
+    TPSAPI void forEachWithPrefix(
+        std::string_view                                                         prefix,
+        std::function<void(std::string_view key, std::string_view value)> const& fn
+    ) const;
+
+    // 将旧版 {key: value} 单键数据拆分为 prefix + key 分别存储，完成后删除旧键
+    TPSAPI void migrateLegacyObject(std::string_view legacyKey, std::string_view prefix);
+
 public:
     virtual ~IStorage() = default;
 
-    virtual void load()      = 0; // 存储加载
-    virtual void unload()    = 0; // 存储卸载
-    virtual void writeBack() = 0; // 存储回写
+    [[nodiscard]] virtual std::string getStorageName() const = 0;
+
+    // 加载前必须完成加载的 Storage 名称, 无依赖的 Storage 会在线程池中并行加载
+    [[nodiscard]] virtual std::vector<std::string> getDependencies() const { return {}; }
+
+    virtual void load()                         = 0; // 存储加载
+    virtual void unload()                       = 0; // 存储卸载
+    virtual void writeBack(StorageBatch& batch) = 0; // 存储回写, 修改写入批次后由 StorageManager 统一提交
+
+    // 按需加载模式 (storage.lazyLoad) 下由 StorageManager 在服务器线程调用, 仅玩家维度的存储需要实现
+    virtual void onPlayerJoin(RealName const& /* realName */) {}       // 异步预加载玩家数据
+    virtual void onPlayerDisconnect(RealName const& /* realName */) {} // 标记离线, 延迟淘汰
+    virtual void evictIdle() {}                                         // 淘汰离线过久或超出容量的玩家
+
+    virtual void onConfigReload() {} // /ltps reload 重载配置后在服务器线程调用
+    virtual void sweep() {}          // 定期在服务器线程调用, 增量清理过期数据, 每次只处理少量记录
+
+    TPSNDAPI bool isDirty() const; // 自上次回写后是否有变更
 };
 
-} // namespace ltps
\ No newline at end of file
+} // namespace ltps
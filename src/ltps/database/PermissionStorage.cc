@@ -2,6 +2,7 @@
 #include "ll/api/io/FileUtils.h"
 #include "ll/api/utils/StringUtils.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/database/PlayerRegistry.h"
 #include "ltps/utils/JsonUtls.h"
 #include "ltps/utils/StringUtils.h"
 #include "magic_enum/magic_enum.hpp"
@@ -9,19 +10,26 @@
 #include "nlohmann/json.hpp"
 #include "nlohmann/json_fwd.hpp"
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 
 namespace ltps {
 
 
-PermissionStorage::PermissionStorage() = default;
+PermissionStorage::PermissionStorage() : mData(std::make_shared<Data>()) {}
+
+std::vector<std::string> PermissionStorage::getDependencies() const { return {PlayerRegistry::name}; }
 
 void PermissionStorage::load() {
     if (_hasLegacyPermissionFile()) {
         _tryLoadLegacyPermissionFile(); // 加载旧版权限文件
         _renameLegacyPermissionFile();  // 重命名旧版权限文件
-        writeBack();                    // 将权限写入数据库
+        markDirty();                    // 下次回写时将权限写入数据库
         TeleportSystem::getInstance().getSelf().getLogger().trace("Loaded legacy permission file");
         return;
     }
@@ -40,24 +48,110 @@ void PermissionStorage::load() {
 
     try {
         auto json = nlohmann::json::parse(rawJson.value());
-
-        json_utils::json2structTryPatch(mData, json);
-
         TeleportSystem::getInstance().getSelf().getLogger().info(
             "Loaded permissions, {} entries",
-            mData.mPlayerPerms.size()
+            loadPersistedData(json)
         );
     } catch (nlohmann::json::parse_error& e) {
         throw std::runtime_error("Failed to parse permissions: " + std::string(e.what()));
     }
+    mergeJournaled();
 }
 
-void PermissionStorage::unload() { writeBack(); }
+void PermissionStorage::unload() {
+    std::lock_guard lock{mMutex};
+    mData = std::make_shared<Data>();
+}
 
-void PermissionStorage::writeBack() {
-    auto& db   = getDatabase();
-    auto  json = json_utils::struct2json(mData);
-    db.set(STORAGE_KEY, json.dump());
+void PermissionStorage::writeBack(StorageBatch& batch) {
+    std::shared_ptr<Data const> snapshot;
+    {
+        std::lock_guard lock{mMutex};
+        snapshot = mData;
+    }
+    batch.set(STORAGE_KEY, dumpData(*snapshot));
+}
+
+void PermissionStorage::publishData(Data data) {
+    std::shared_ptr<Data const> next = std::make_shared<Data>(std::move(data));
+    {
+        std::lock_guard lock{mMutex};
+        mData.swap(next);
+    }
+    markDirty();
+}
+
+void PermissionStorage::journalPlayer(RealName const& realName) {
+    auto perms = findPlayerPerms(realName);
+    journalSet(JOURNAL_PREFIX + realName, std::to_string(perms ? *perms : 0));
+}
+
+void PermissionStorage::journalDefault() { journalSet(DEFAULT_JOURNAL_KEY, std::to_string(mData->mDefaultPerms)); }
+
+void PermissionStorage::mergeJournaled() {
+    auto&                    db   = getDatabase();
+    auto                     data = *mData;
+    std::vector<std::string> keys;
+    forEachWithPrefix(JOURNAL_PREFIX, [&](std::string_view realName, std::string_view value) {
+        keys.emplace_back(JOURNAL_PREFIX + std::string{realName});
+        data.mPlayerPerms[getPlayerRegistry().intern(RealName{realName})] = std::stoi(std::string{value});
+    });
+    if (auto value = db.get(DEFAULT_JOURNAL_KEY)) {
+        keys.emplace_back(DEFAULT_JOURNAL_KEY);
+        data.mDefaultPerms = std::stoi(*value);
+    }
+    if (keys.empty()) {
+        return;
+    }
+
+    // 先写入合并后的主数据再删除日志记录, 中途失败时下次加载会重新合并 (结果相同)
+    if (!db.set(STORAGE_KEY, dumpData(data))) {
+        throw std::runtime_error("Failed to save merged permissions");
+    }
+    for (auto const& key : keys) {
+        if (!db.del(key)) {
+            throw std::runtime_error("Failed to delete journaled permission: " + key);
+        }
+    }
+    {
+        std::lock_guard lock{mMutex};
+        mData = std::make_shared<Data>(std::move(data));
+    }
+    TeleportSystem::getInstance().getSelf().getLogger().info("Merged {} journaled permissions", keys.size());
+}
+
+std::size_t PermissionStorage::loadPersistedData(nlohmann::json& json) {
+    PersistedData persisted;
+    json_utils::json2structTryPatch(persisted, json);
+
+    auto& registry = getPlayerRegistry();
+    Data  data{.mDefaultPerms = persisted.mDefaultPerms};
+    data.mPlayerPerms.reserve(persisted.mPlayerPerms.size());
+    for (auto const& [realName, perms] : persisted.mPlayerPerms) {
+        data.mPlayerPerms.emplace(registry.intern(realName), perms);
+    }
+
+    std::lock_guard lock{mMutex};
+    mData = std::make_shared<Data>(std::move(data));
+    return persisted.mPlayerPerms.size();
+}
+
+std::string PermissionStorage::dumpData(Data const& data) {
+    auto&         registry = getPlayerRegistry();
+    PersistedData persisted{.mDefaultPerms = data.mDefaultPerms};
+    for (auto const& [id, perms] : data.mPlayerPerms) {
+        persisted.mPlayerPerms.emplace(registry.getName(id), perms);
+    }
+    return json_utils::struct2json(persisted).dump();
+}
+
+int const* PermissionStorage::findPlayerPerms(RealName const& realName) const {
+    auto id = getPlayerRegistry().find(realName);
+    if (!id) {
+        return nullptr;
+    }
+    auto iter = mData->mPlayerPerms.find(*id);
+    return iter == mData->mPlayerPerms.end() ? nullptr : &iter->second;
 }
 
 
@@ -79,12 +173,9 @@ void PermissionStorage::_tryLoadLegacyPermissionFile() {
 
     try {
         auto json = nlohmann::json::parse(content.value());
-
-        json_utils::json2structTryPatch(mData, json);
-
         TeleportSystem::getInstance().getSelf().getLogger().info(
             "Loaded legacy permissions, {} entries",
-            mData.mPlayerPerms.size()
+            loadPersistedData(json)
         );
     } catch (nlohmann::json::parse_error& e) {
         throw std::runtime_error("Failed to parse legacy permission file: " + std::string(e.what()));
@@ -101,29 +192,36 @@ void PermissionStorage::_renameLegacyPermissionFile() const {
 
 
 bool PermissionStorage::hasDefaultPermission(Permission permission) const {
-    return (mData.mDefaultPerms & static_cast<int>(permission)) != 0;
+    return (mData->mDefaultPerms & static_cast<int>(permission)) != 0;
 }
 
 bool PermissionStorage::hasPermission(RealName const& realName, Permission permission, bool includeDefault) const {
     if (includeDefault && hasDefaultPermission(permission)) return true;
-    if (!mData.mPlayerPerms.contains(realName)) return false;
-    return (mData.mPlayerPerms.at(realName) & static_cast<int>(permission)) != 0;
+    auto perms = findPlayerPerms(realName);
+    if (!perms) return false;
+    return (*perms & static_cast<int>(permission)) != 0;
 }
 
 Result<void> PermissionStorage::grantPermission(RealName const& realName, Permission permission) {
     if (hasPermission(realName, permission, false)) return std::unexpected("Permission already granted");
-    mData.mPlayerPerms[realName] |= static_cast<int>(permission);
+    auto data                                           = *mData; // 写时复制
+    data.mPlayerPerms[getPlayerRegistry().intern(realName)] |= static_cast<int>(permission);
+    publishData(std::move(data));
+    journalPlayer(realName);
     return {};
 }
 
 Result<void> PermissionStorage::revokePermission(RealName const& realName, Permission permission) {
     if (!hasPermission(realName, permission, false)) return std::unexpected("Permission not granted");
-    mData.mPlayerPerms[realName] &= ~static_cast<int>(permission);
+    auto data                                           = *mData; // 写时复制
+    data.mPlayerPerms[getPlayerRegistry().intern(realName)] &= ~static_cast<int>(permission);
+    publishData(std::move(data));
+    journalPlayer(realName);
     return {};
 }
 
 std::vector<PermissionStorage::Permission> PermissionStorage::getPermissions(RealName const& realName) const {
-    if (!mData.mPlayerPerms.contains(realName)) return {};
+    if (!findPlayerPerms(realName)) return {};
     std::vector<Permission> result;
     for (auto const& p : magic_enum::enum_values<Permission>()) {
         if (hasPermission(realName, p, false)) result.push_back(p);
@@ -134,13 +232,19 @@ std::vector<PermissionStorage::Permission> PermissionStorage::getPermissions(Rea
 
 Result<void> PermissionStorage::grantDefaultPermission(Permission permission) {
     if (hasDefaultPermission(permission)) return std::unexpected("Permission already granted");
-    mData.mDefaultPerms |= static_cast<int>(permission);
+    auto data           = *mData; // 写时复制
+    data.mDefaultPerms |= static_cast<int>(permission);
+    publishData(std::move(data));
+    journalDefault();
     return {};
 }
 
 Result<void> PermissionStorage::revokeDefaultPermission(Permission permission) {
     if (!hasDefaultPermission(permission)) return std::unexpected("Permission not granted");
-    mData.mDefaultPerms &= ~static_cast<int>(permission);
+    auto data           = *mData; // 写时复制
+    data.mDefaultPerms &= ~static_cast<int>(permission);
+    publishData(std::move(data));
+    journalDefault();
     return {};
 }
 
@@ -154,7 +258,7 @@ std::vector<PermissionStorage::Permission> PermissionStorage::getDefaultPermissi
 
 Result<std::pair<std::vector<PermissionStorage::Permission>, std::vector<PermissionStorage::Permission>>>
 PermissionStorage::tracePermissions(RealName const& realName) const {
-    if (!mData.mPlayerPerms.contains(realName)) {
+    if (!findPlayerPerms(realName)) {
         return std::unexpected("Player not found");
     }
     auto defaultPerms = getDefaultPermissions();
@@ -1,7 +1,13 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/database/IStorage.h"
+#include "nlohmann/json_fwd.hpp"
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -15,9 +21,14 @@ class PermissionStorage final : public IStorage {
 public:
     TPSAPI explicit PermissionStorage();
 
+    inline static std::string name = "PermissionStorage";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
+    TPSNDAPI std::vector<std::string> getDependencies() const override;
+
     TPSAPI void load() override;
     TPSAPI void unload() override;
-    TPSAPI void writeBack() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
 
     // 旧数据兼容
     TPSNDAPI bool _hasLegacyPermissionFile() const;
@@ -25,10 +36,26 @@ class PermissionStorage final : public IStorage {
     TPSAPI void   _renameLegacyPermissionFile() const;
 
 private:
-    struct {
+    struct Data {
         int                               mDefaultPerms{0}; // 默认权限
-        std::unordered_map<RealName, int> mPlayerPerms;     // 玩家权限
-    } mData;
+        std::unordered_map<PlayerId, int> mPlayerPerms;     // 玩家权限
+    };
+    struct PersistedData { // 持久化格式, 与旧版权限文件相同, 玩家以名称为键
+        int                               mDefaultPerms{0};
+        std::unordered_map<RealName, int> mPlayerPerms;
+    };
+    std::shared_ptr<Data const> mData;  // 写时复制, 回写线程序列化快照
+    mutable std::mutex          mMutex; // 仅保护 mData 指针的替换与读取快照
+
+    void        publishData(Data data);
+    void        journalPlayer(RealName const& realName); // 将单个玩家的当前权限写入日志
+    void        journalDefault();                        // 将当前默认权限写入日志
+    void        mergeJournaled();                        // 加载时合并重放到数据库的日志记录
+    std::size_t loadPersistedData(nlohmann::json& json); // 解析持久化数据并替换 mData, 返回条目数
+
+    static std::string dumpData(Data const& data);
+
+    int const* findPlayerPerms(RealName const& realName) const;
 
 public:
     enum class Permission : int {
@@ -93,8 +120,10 @@ class PermissionStorage final : public IStorage {
     TPSNDAPI static std::vector<Permission>   getPermissions();                   // 获取所有权限
     TPSNDAPI static Result<std::vector<PermissionStorage::Permission>> resolve(std::string const& permissions);
 
-    static inline constexpr auto STORAGE_KEY      = "permission";
-    static inline constexpr auto LEGACY_FILE_NAME = "permission.json";
+    static inline constexpr auto STORAGE_KEY         = "permission";
+    static inline constexpr auto JOURNAL_PREFIX      = "permission/";       // 日志记录 permission/<realName>
+    static inline constexpr auto DEFAULT_JOURNAL_KEY = "permission#default"; // 默认权限的日志记录
+    static inline constexpr auto LEGACY_FILE_NAME    = "permission.json";
 };
 
 
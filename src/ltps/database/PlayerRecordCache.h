@@ -0,0 +1,132 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/database/CowRecordMap.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+
+namespace ltps {
+
+/**
+ * @brief 按玩家划分的记录缓存 (按需加载模式)，以 PlayerRegistry 分配的 PlayerId 为键
+ * 在 CowRecordMap 的基础上记录每个玩家的最近访问顺序与在线状态:
+ *  - 玩家进服时预加载，首次访问未缓存的玩家时同步加载 (管理员操作离线玩家)
+ *  - 玩家离线超过 evictDelay 后淘汰，缓存的离线玩家超过 capacity 时按最近最少使用淘汰
+ *  - 存在未写入数据库的变更时不会淘汰，也不会从数据库重新加载
+ *
+ * 未启用按需加载时退化为普通的 CowRecordMap，所有方法均只在服务器线程调用。
+ */
+template <typename T>
+class PlayerRecordCache : public CowRecordMap<T, PlayerId> {
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::list<PlayerId>::iterator lruIter;
+        Clock::time_point             offlineSince;
+        bool                          online{false};
+    };
+
+    bool                                        mLazy{false};
+    std::uint64_t                               mEvictionEpoch{0}; // 每次淘汰递增, 用于丢弃过期的异步加载结果
+    mutable std::list<PlayerId>                 mLru;              // 最近访问的玩家在前
+    mutable std::unordered_map<PlayerId, Entry> mEntries;
+
+    void touchImpl(PlayerId id) const {
+        if (auto iter = mEntries.find(id); iter != mEntries.end()) {
+            mLru.splice(mLru.begin(), mLru, iter->second.lruIter);
+            return;
+        }
+        mLru.push_front(id);
+        mEntries.emplace(id, Entry{mLru.begin(), Clock::now(), false});
+    }
+
+public:
+    void setLazy(bool lazy) { mLazy = lazy; }
+
+    [[nodiscard]] bool isLazy() const { return mLazy; }
+
+    [[nodiscard]] std::uint64_t getEvictionEpoch() const { return mEvictionEpoch; }
+
+    // 访问玩家记录前调用: 按需加载模式下未缓存时通过 loader 从数据库读取 (返回 std::nullopt 表示无数据)
+    template <typename Loader>
+    void ensureLoaded(PlayerId id, Loader&& loader) {
+        if (!mLazy) {
+            return;
+        }
+        touchImpl(id);
+        if (this->contains(id) || this->isPending(id)) {
+            return;
+        }
+        if (std::optional<T> value = loader(); value) {
+            this->emplaceClean(id, std::move(*value));
+        }
+    }
+
+    // 发布异步加载的结果, 期间已加载、已修改或发生过淘汰时丢弃
+    void emplaceLoaded(PlayerId id, T value, std::uint64_t epoch) {
+        if (!mLazy || epoch != mEvictionEpoch || this->contains(id) || this->isPending(id)) {
+            return;
+        }
+        touchImpl(id);
+        this->emplaceClean(id, std::move(value));
+    }
+
+    void setOnline(PlayerId id, bool online) {
+        if (!mLazy) {
+            return;
+        }
+        touchImpl(id);
+        auto& entry        = mEntries.at(id);
+        entry.online       = online;
+        entry.offlineSince = Clock::now();
+    }
+
+    // 淘汰离线过久或超出容量的玩家, 返回淘汰数量
+    std::size_t evictIdle(std::size_t capacity, std::chrono::seconds delay) {
+        if (!mLazy) {
+            return 0;
+        }
+        auto        now     = Clock::now();
+        std::size_t offline = 0;
+        for (auto const& [_, entry] : mEntries) {
+            offline += entry.online ? 0 : 1;
+        }
+
+        std::size_t evicted = 0;
+        for (auto iter = mLru.end(); iter != mLru.begin();) {
+            auto id    = *--iter;
+            auto entry = mEntries.find(id);
+            if (entry->second.online) {
+                continue;
+            }
+            if (offline <= capacity && now - entry->second.offlineSince < delay) {
+                continue;
+            }
+            if (this->isPending(id)) {
+                continue; // 等待回写完成后再淘汰
+            }
+            this->tryEvict(id);
+            mEntries.erase(entry);
+            iter = mLru.erase(iter);
+            --offline;
+            ++evicted;
+        }
+        if (evicted > 0) {
+            ++mEvictionEpoch;
+        }
+        return evicted;
+    }
+
+    void clear() {
+        CowRecordMap<T, PlayerId>::clear();
+        mLru.clear();
+        mEntries.clear();
+    }
+};
+
+} // namespace ltps
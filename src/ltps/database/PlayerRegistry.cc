@@ -0,0 +1,119 @@
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/utils/BinaryUtils.h"
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+
+namespace ltps {
+
+namespace {
+
+std::string encodeId(PlayerId id) { return binary_utils::Writer{4}.writeU32(id).release(); }
+
+} // namespace
+
+
+PlayerRegistry::PlayerRegistry() = default;
+
+void PlayerRegistry::load() {
+    std::vector<std::pair<PlayerId, RealName>> entries;
+    forEachWithPrefix(KEY_PREFIX, [&](std::string_view realName, std::string_view value) {
+        if (value.size() != 4) {
+            throw std::runtime_error("Invalid player id of player: " + std::string{realName});
+        }
+        entries.emplace_back(binary_utils::Reader{value}.readU32(), RealName{realName});
+    });
+    std::sort(entries.begin(), entries.end());
+
+    std::unique_lock lock{mMutex};
+    mNames.clear();
+    mIds.clear();
+    mPending.clear();
+    mInFlight.clear();
+    for (auto& [id, realName] : entries) {
+        if (id < mNames.size()) {
+            throw std::runtime_error("Duplicate player id: " + std::to_string(id));
+        }
+        mNames.resize(id); // 理论上不会出现空洞, 出现时留空名称占位以保持 ID 不变
+        mIds.emplace(mNames.emplace_back(std::move(realName)), id);
+    }
+
+    TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} player ids", mIds.size());
+}
+
+void PlayerRegistry::unload() {
+    std::unique_lock lock{mMutex};
+    mNames.clear();
+    mIds.clear();
+    mPending.clear();
+    mInFlight.clear();
+}
+
+void PlayerRegistry::writeBack(StorageBatch& batch) {
+    {
+        std::unique_lock lock{mMutex};
+        mInFlight.insert(mInFlight.end(), mPending.begin(), mPending.end());
+        mPending.clear();
+        for (auto const& [realName, id] : mInFlight) {
+            batch.set(KEY_PREFIX + realName, encodeId(id));
+        }
+    }
+    batch.onComplete([this](bool succeeded) {
+        if (succeeded) {
+            std::unique_lock lock{mMutex};
+            mInFlight.clear();
+        } else {
+            markDirty(); // 保留在 mInFlight 中, 下次回写时重新写入
+        }
+    });
+}
+
+PlayerId PlayerRegistry::emplace(RealName realName) {
+    auto id = static_cast<PlayerId>(mNames.size());
+    mIds.emplace(mNames.emplace_back(std::move(realName)), id);
+    mPending.emplace_back(mNames.back(), id);
+    return id;
+}
+
+PlayerId PlayerRegistry::intern(RealName const& realName) {
+    if (auto id = find(realName)) {
+        return *id;
+    }
+
+    PlayerId id;
+    {
+        std::unique_lock lock{mMutex};
+        if (auto iter = mIds.find(realName); iter != mIds.end()) {
+            return iter->second; // 其它线程已分配
+        }
+        id = emplace(realName);
+    }
+    markDirty();
+    journalSet(KEY_PREFIX + realName, encodeId(id));
+    return id;
+}
+
+std::optional<PlayerId> PlayerRegistry::find(RealName const& realName) const {
+    std::shared_lock lock{mMutex};
+    if (auto iter = mIds.find(realName); iter != mIds.end()) {
+        return iter->second;
+    }
+    return std::nullopt;
+}
+
+RealName const& PlayerRegistry::getName(PlayerId id) const {
+    static RealName const empty{};
+    std::shared_lock      lock{mMutex};
+    return id < mNames.size() ? mNames[id] : empty;
+}
+
+std::size_t PlayerRegistry::size() const {
+    std::shared_lock lock{mMutex};
+    return mIds.size();
+}
+
+
+} // namespace ltps
@@ -0,0 +1,62 @@
+#pragma once
+#include "ltps/Global.h"
+#include "ltps/database/IStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace ltps {
+
+/**
+ * @brief 玩家注册表 (PlayerRegistry)
+ * 将玩家名称 (RealName) 映射为从 0 开始连续分配的 PlayerId，各玩家维度的存储与冷却在内存中以 PlayerId 为键，
+ * 玩家名称只在此处保存一份。数据库中的键仍使用玩家名称，PlayerId 只在本插件内部使用。
+ *
+ * 映射持久化在 pid/<realName> 键下，ID 一经分配不会回收或改变。
+ * 所有方法都是线程安全的 (存储在线程池中并行加载时会同时分配 ID)。
+ */
+class PlayerRegistry final : public IStorage {
+    std::deque<RealName>                           mNames;    // PlayerId -> 玩家名称, deque 保证引用稳定
+    std::unordered_map<std::string_view, PlayerId> mIds;      // 玩家名称 -> PlayerId, 键引用 mNames 中的字符串
+    std::vector<std::pair<RealName, PlayerId>>     mPending;  // 尚未写入数据库的映射
+    std::vector<std::pair<RealName, PlayerId>>     mInFlight; // 回写中的映射, 失败时下次回写重新写入
+    mutable std::shared_mutex                      mMutex;
+
+    PlayerId emplace(RealName realName); // 调用方须持有写锁
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(PlayerRegistry);
+
+    TPSAPI explicit PlayerRegistry();
+
+    inline static std::string name = "PlayerRegistry";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
+    TPSAPI void load() override;
+    TPSAPI void unload() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
+
+    // 获取玩家的 ID, 未注册时分配新 ID
+    TPSNDAPI PlayerId intern(RealName const& realName);
+
+    // 仅查找, 未注册时返回 std::nullopt
+    TPSNDAPI std::optional<PlayerId> find(RealName const& realName) const;
+
+    // 获取 ID 对应的玩家名称, ID 无效时返回空字符串
+    TPSNDAPI RealName const& getName(PlayerId id) const;
+
+    TPSNDAPI std::size_t size() const;
+
+    static inline constexpr auto KEY_PREFIX = "pid/"; // pid/<realName> -> PlayerId (u32, 小端序)
+};
+
+
+} // namespace ltps
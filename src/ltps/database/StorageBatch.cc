@@ -0,0 +1,119 @@
+#include "ltps/database/StorageBatch.h"
+#include "ltps/utils/BinaryUtils.h"
+#include <stdexcept>
+#include <utility>
+
+
+namespace ltps {
+
+
+StorageBatch::StorageBatch() = default;
+
+void StorageBatch::set(std::string key, std::string value) {
+    mBytes += key.size() + value.size();
+    mEntries.push_back({Op::Set, std::move(key), std::move(value)});
+}
+
+void StorageBatch::del(std::string key) {
+    mBytes += key.size();
+    mEntries.push_back({Op::Del, std::move(key), {}});
+}
+
+std::size_t StorageBatch::mark() const { return mEntries.size(); }
+
+void StorageBatch::rollback(std::size_t mark) {
+    while (mEntries.size() > mark) {
+        mBytes -= mEntries.back().key.size() + mEntries.back().value.size();
+        mEntries.pop_back();
+    }
+}
+
+void StorageBatch::onComplete(std::function<void(bool succeeded)> callback) {
+    mCallbacks.push_back(std::move(callback));
+}
+
+bool        StorageBatch::empty() const { return mEntries.empty(); }
+std::size_t StorageBatch::size() const { return mEntries.size(); }
+std::size_t StorageBatch::getBytes() const { return mBytes; }
+
+// v1: [header][count: varint] { [op: u8][key][value] } * count
+std::string StorageBatch::encode() const {
+    binary_utils::Writer writer{mBytes + mEntries.size() * 4 + 8};
+    writer.writeHeader(BINARY_VERSION).writeVarUInt(mEntries.size());
+    for (auto const& entry : mEntries) {
+        writer.writeU8(static_cast<std::uint8_t>(entry.op)).writeString(entry.key).writeString(entry.value);
+    }
+    return writer.release();
+}
+
+std::vector<StorageBatch::Entry> StorageBatch::decode(std::string_view data) {
+    binary_utils::Reader reader{data};
+    if (auto version = reader.readHeader(); version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported storage batch version: " + std::to_string(version));
+    }
+    std::vector<Entry> entries;
+    auto               count = reader.readVarUInt();
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Entry entry;
+        entry.op    = static_cast<Op>(reader.readU8());
+        entry.key   = reader.readString();
+        entry.value = reader.readString();
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+void StorageBatch::apply(ll::data::KeyValueDB& db, std::vector<Entry> const& entries) {
+    for (auto const& entry : entries) {
+        if (entry.op == Op::Del) {
+            db.del(entry.key);
+            continue;
+        }
+        if (!db.set(entry.key, entry.value)) {
+            throw std::runtime_error("Could not write key: " + entry.key);
+        }
+    }
+}
+
+void StorageBatch::complete(bool succeeded) {
+    for (auto& callback : mCallbacks) {
+        callback(succeeded);
+    }
+    mCallbacks.clear();
+}
+
+void StorageBatch::commit(ll::data::KeyValueDB& db, std::size_t storages) {
+    if (mEntries.empty()) {
+        complete(true);
+        return;
+    }
+    try {
+        if (mEntries.size() == 1 || storages <= 1) {
+            apply(db, mEntries); // 单条写入本身即是原子的, 单个 Storage 中途失败时由预写日志补齐
+        } else {
+            if (!db.set(COMMIT_KEY, encode())) {
+                throw std::runtime_error("Could not write storage batch");
+            }
+            apply(db, mEntries);
+            db.del(COMMIT_KEY);
+        }
+    } catch (...) {
+        complete(false);
+        throw;
+    }
+    complete(true);
+}
+
+std::size_t StorageBatch::recover(ll::data::KeyValueDB& db) {
+    auto data = db.get(COMMIT_KEY);
+    if (!data) {
+        return 0;
+    }
+    auto entries = decode(*data);
+    apply(db, entries);
+    db.del(COMMIT_KEY);
+    return entries.size();
+}
+
+
+} // namespace ltps
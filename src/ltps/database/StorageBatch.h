@@ -0,0 +1,85 @@
+#pragma once
+#include "ll/api/data/KeyValueDB.h"
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace ltps {
+
+/**
+ * @brief 跨存储的批量写入 (StorageBatch)
+ * 一次回写中所有 Storage 的修改先收集到同一个批次，再由 StorageManager 统一提交。
+ *
+ * KeyValueDB 没有暴露 LevelDB 的 WriteBatch，这里用"先整体写入再逐条应用"实现原子性:
+ *  1. 将整个批次编码后写入 COMMIT_KEY (单次 put 本身是原子的)
+ *  2. 逐条应用到各自的键
+ *  3. 删除 COMMIT_KEY
+ * 若在第 2 步中崩溃，下次启动时 recover() 会重新应用该批次 (set/del 可重复执行)。
+ *
+ * 代价: 每个条目实际写入两次 (COMMIT_KEY 中一次, 目标键一次), 另有一次删除, 且各次写入均不单独 fsync。
+ * 因此只有一个条目或只有一个 Storage 参与时跳过 COMMIT_KEY 直接应用: 单个 Storage 的修改都已写入预写日志,
+ * 日志在提交成功后才压缩, 中途崩溃时由启动时的日志重放补齐。
+ */
+class StorageBatch final {
+public:
+    enum class Op : std::uint8_t {
+        Set = 1,
+        Del = 2,
+    };
+
+    struct Entry {
+        Op          op;
+        std::string key;
+        std::string value;
+    };
+
+private:
+    std::vector<Entry>                     mEntries;
+    std::vector<std::function<void(bool)>> mCallbacks; // 提交结束后按注册顺序调用, 参数为是否成功
+    std::size_t                            mBytes{0};
+
+public:
+    TPS_DISALLOW_COPY(StorageBatch);
+
+    TPSAPI explicit StorageBatch();
+
+    TPSAPI void set(std::string key, std::string value);
+    TPSAPI void del(std::string key);
+
+    // 撤销 mark 之后加入的条目 (用于丢弃回写中途抛出异常的 Storage 的部分修改)
+    TPSNDAPI std::size_t mark() const;
+    TPSAPI void          rollback(std::size_t mark);
+
+    // 注册提交结果回调, Storage 据此确认快照或重新标记为脏
+    TPSAPI void onComplete(std::function<void(bool succeeded)> callback);
+
+    // 提交到数据库, storages 为参与本批次的 Storage 数, 多于一个时经由 COMMIT_KEY 原子提交;
+    // 失败时抛出异常 (回调仍会以 false 调用)
+    TPSAPI void commit(ll::data::KeyValueDB& db, std::size_t storages);
+
+    // 重新应用上次未完成的批次, 返回应用的条目数
+    TPSAPI static std::size_t recover(ll::data::KeyValueDB& db);
+
+    TPSNDAPI bool        empty() const;
+    TPSNDAPI std::size_t size() const;
+    TPSNDAPI std::size_t getBytes() const;
+
+    static inline constexpr auto         COMMIT_KEY     = "__batch__";
+    static inline constexpr std::uint8_t BINARY_VERSION = 1;
+
+private:
+    std::string encode() const;
+
+    static std::vector<Entry> decode(std::string_view data);
+
+    static void apply(ll::data::KeyValueDB& db, std::vector<Entry> const& entries);
+
+    void complete(bool succeeded);
+};
+
+} // namespace ltps
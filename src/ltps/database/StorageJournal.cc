@@ -0,0 +1,160 @@
+#include "ltps/database/StorageJournal.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/utils/BinaryUtils.h"
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+
+namespace ltps {
+
+namespace {
+
+std::uint32_t fnv1a(std::string_view data) {
+    std::uint32_t hash = 2166136261u;
+    for (auto c : data) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+
+StorageJournal::StorageJournal(std::filesystem::path path)
+: mPath(std::move(path)),
+  mCompactingPath(std::filesystem::path{mPath}.concat(".old")) {}
+
+bool StorageJournal::openStream() {
+    if (!mStream.is_open()) {
+        mStream.clear();
+        mStream.open(mPath, std::ios::binary | std::ios::app);
+    }
+    return mStream.good();
+}
+
+void StorageJournal::append(Op op, std::string_view key, std::string_view value) {
+    binary_utils::Writer payload{key.size() + value.size() + 8};
+    payload.writeU8(static_cast<std::uint8_t>(op)).writeString(key).writeString(value);
+    auto body = payload.release();
+
+    binary_utils::Writer record{body.size() + 8};
+    record.writeU32(static_cast<std::uint32_t>(body.size())).writeBytes(body).writeU32(fnv1a(body));
+    auto buffer = record.release();
+
+    std::lock_guard lock{mMutex};
+    if (!openStream()) {
+        // 日志不可用时修改仍会在下次定时回写时落盘, 不中断调用方
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "StorageJournal: Could not write to {}",
+            mPath.string()
+        );
+        mStream.close();
+        return;
+    }
+    mStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    mStream.flush(); // 写入操作系统缓冲区, 进程崩溃不会丢失
+    mBytes   += buffer.size();
+    mRecords += 1;
+}
+
+std::size_t StorageJournal::replayFile(std::filesystem::path const& path, ll::data::KeyValueDB& db) {
+    std::ifstream stream{path, std::ios::binary};
+    if (!stream) {
+        return 0;
+    }
+    std::string data{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+    std::size_t          count = 0;
+    binary_utils::Reader reader{data};
+    try {
+        while (!reader.eof()) {
+            auto size = reader.readU32();
+            auto body = reader.readBytes(size);
+            if (reader.readU32() != fnv1a(body)) {
+                throw std::runtime_error("checksum mismatch");
+            }
+
+            binary_utils::Reader payload{body};
+            auto                 op    = static_cast<Op>(payload.readU8());
+            auto                 key   = payload.readStringView();
+            auto                 value = payload.readStringView();
+            switch (op) {
+            case Op::Set:
+                db.set(key, value);
+                break;
+            case Op::Del:
+                db.del(key);
+                break;
+            default:
+                throw std::runtime_error("unknown op");
+            }
+            ++count;
+        }
+    } catch (std::exception const& e) {
+        // 崩溃时最后一条记录可能只写入了一部分, 丢弃其后的内容
+        TeleportSystem::getInstance().getSelf().getLogger().warn(
+            "StorageJournal: Discarded tail of {} after {} records: {}",
+            path.filename().string(),
+            count,
+            e.what()
+        );
+    }
+    return count;
+}
+
+std::size_t StorageJournal::replay(ll::data::KeyValueDB& db) {
+    std::lock_guard lock{mMutex};
+    mStream.close();
+
+    auto count  = replayFile(mCompactingPath, db);
+    count      += replayFile(mPath, db);
+
+    std::error_code ec;
+    std::filesystem::remove(mCompactingPath, ec);
+    std::filesystem::remove(mPath, ec);
+    mBytes   = 0;
+    mRecords = 0;
+    return count;
+}
+
+void StorageJournal::beginCompaction() {
+    std::lock_guard lock{mMutex};
+    mStream.close();
+    if (!std::filesystem::exists(mPath)) {
+        return;
+    }
+
+    if (!std::filesystem::exists(mCompactingPath)) {
+        std::filesystem::rename(mPath, mCompactingPath);
+    } else {
+        // 上次压缩未完成 (回写失败), 追加到 .old 段之后以保持记录顺序
+        std::ifstream in{mPath, std::ios::binary};
+        std::ofstream out{mCompactingPath, std::ios::binary | std::ios::app};
+        out << in.rdbuf();
+        in.close();
+        out.close();
+        std::filesystem::remove(mPath);
+    }
+    mBytes   = 0;
+    mRecords = 0;
+}
+
+void StorageJournal::commitCompaction() {
+    std::lock_guard lock{mMutex};
+    std::error_code ec;
+    std::filesystem::remove(mCompactingPath, ec);
+}
+
+std::size_t StorageJournal::getBytes() const {
+    std::lock_guard lock{mMutex};
+    return mBytes;
+}
+std::size_t StorageJournal::getRecords() const {
+    std::lock_guard lock{mMutex};
+    return mRecords;
+}
+
+
+} // namespace ltps
@@ -0,0 +1,64 @@
+#pragma once
+#include "ll/api/data/KeyValueDB.h"
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+
+namespace ltps {
+
+/**
+ * @brief 存储预写日志 (Write-Ahead Journal)
+ * 每次修改在发布到内存后追加一条键值级别的记录 (set / del)，崩溃后在下次加载时重放到数据库。
+ *
+ * 文件:
+ *  - <name>      当前段，所有新记录追加到此文件
+ *  - <name>.old  压缩中的段，回写开始前由当前段轮转得到，全部存储回写成功后删除
+ *
+ * 记录格式: [payload 长度: u32][payload][FNV-1a 校验: u32]
+ *          payload = [op: u8][key][value]，末尾不完整或校验失败的记录会被丢弃
+ */
+class StorageJournal final {
+public:
+    enum class Op : std::uint8_t {
+        Set = 1,
+        Del = 2,
+    };
+
+private:
+    std::filesystem::path mPath;
+    std::filesystem::path mCompactingPath;
+    std::ofstream         mStream;
+    std::size_t           mBytes{0};   // 当前段大小
+    std::size_t           mRecords{0}; // 当前段记录数
+    mutable std::mutex    mMutex;
+
+    bool openStream();
+
+    static std::size_t replayFile(std::filesystem::path const& path, ll::data::KeyValueDB& db);
+
+public:
+    TPS_DISALLOW_COPY_AND_MOVE(StorageJournal);
+
+    TPSAPI explicit StorageJournal(std::filesystem::path path);
+
+    TPSAPI void append(Op op, std::string_view key, std::string_view value = {});
+
+    // 将 .old 段与当前段按顺序重放到数据库，完成后清空日志，返回重放的记录数
+    TPSAPI std::size_t replay(ll::data::KeyValueDB& db);
+
+    // 回写开始前调用: 将当前段并入 .old 段，之后的修改写入新的当前段
+    TPSAPI void beginCompaction();
+
+    // 所有存储回写成功后调用: 删除 .old 段
+    TPSAPI void commitCompaction();
+
+    TPSNDAPI std::size_t getBytes() const;
+    TPSNDAPI std::size_t getRecords() const;
+};
+
+} // namespace ltps
@@ -1,58 +1,331 @@
 #include "ltps/database/StorageManager.h"
+#include "ll/api/chrono/GameChrono.h"
 #include "ll/api/coro/CoroTask.h"
 #include "ll/api/data/KeyValueDB.h"
+#include "ll/api/event/EventBus.h"
+#include "ll/api/event/player/PlayerDisconnectEvent.h"
+#include "ll/api/event/player/PlayerJoinEvent.h"
+#include "ll/api/thread/ServerThreadExecutor.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "magic_enum/magic_enum.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <latch>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 namespace ltps {
 
-StorageManager::StorageManager(ll::thread::ThreadPoolExecutor& threadPoolExecutor) {
+StorageManager::StorageManager(ll::thread::ThreadPoolExecutor& threadPoolExecutor, TimerService& timerService)
+: mThreadPool(threadPoolExecutor),
+  mTimerService(timerService) {
     if (!mDatabase) {
-        auto path = TeleportSystem::getInstance().getSelf().getModDir() / "leveldb";
-        mDatabase = std::make_unique<ll::data::KeyValueDB>(path);
-    }
-    mInterruptableSleep     = std::make_shared<ll::coro::InterruptableSleep>();
-    mWriteBackTaskAbortFlag = std::make_shared<std::atomic_bool>(false);
-
-    ll::coro::keepThis(
-        [this, interruptableSleep = mInterruptableSleep, writeBackTaskAbortFlag = mWriteBackTaskAbortFlag](
-        ) -> ll::coro::CoroTask<> {
-            while (!writeBackTaskAbortFlag->load()) {
-                co_await interruptableSleep->sleepFor(std::chrono::seconds(60));
-                if (writeBackTaskAbortFlag->load()) {
-                    break;
-                }
+        auto dir  = TeleportSystem::getInstance().getSelf().getModDir();
+        mDatabase = std::make_unique<ll::data::KeyValueDB>(dir / "leveldb");
+        mJournal  = std::make_unique<StorageJournal>(dir / "leveldb.journal");
+    }
+    mLastWriteBackTime = std::chrono::steady_clock::now();
+
+    // 玩家维度的存储与冷却均依赖注册表, 由 StorageManager 自身注册
+    registerStorage<PlayerRegistry>();
+    mPlayerRegistry = getStorage<PlayerRegistry>();
+
+    // 每秒在线程池中按回写策略检查一次, requestWriteBack() 会立即触发一次检查
+    mWriteBackTimer = mTimerService.scheduleEvery(
+        std::chrono::seconds{1},
+        [this] {
+            if (auto reason = pollWriteBack()) {
+                TeleportSystem::getInstance().getSelf().getLogger().debug(
+                    "StorageManager: Write back triggered by {}",
+                    magic_enum::enum_name(*reason)
+                );
                 postWriteBack();
             }
-            co_return;
+        },
+        TimerService::Dispatch::ThreadPool
+    );
+}
+
+std::optional<StorageManager::WriteBackReason> StorageManager::pollWriteBack() {
+    if (mWriteBackRequested.exchange(false)) {
+        return WriteBackReason::Requested;
+    }
+
+    auto& policy  = getConfig().storage.writeBack;
+    auto  elapsed = getTimeSinceLastWriteBack();
+    if (elapsed >= std::chrono::seconds{policy.maxInterval}) {
+        std::lock_guard lock{mWriteBackMutex};
+        if (!hasPendingWriteBack()) {
+            return std::nullopt; // 无修改时不轮转日志, 也不重置计时
+        }
+        return WriteBackReason::MaxInterval;
+    }
+    if (elapsed < std::chrono::seconds{policy.minInterval}) {
+        return std::nullopt;
+    }
+
+    // 待回写的修改即是预写日志中尚未压缩的记录
+    auto& journal = *mJournal;
+    if (journal.getRecords() < static_cast<std::size_t>(policy.pendingMutations)
+        && journal.getBytes() < static_cast<std::size_t>(policy.pendingBytes)) {
+        return std::nullopt;
+    }
+    if (isUnderTickPressure()) {
+        mDeferredWriteBackCount.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt; // 服务器繁忙, 推迟到负载下降或达到最长回写间隔
+    }
+    return WriteBackReason::Threshold;
+}
+
+void StorageManager::requestWriteBack() {
+    mWriteBackRequested.store(true);
+    mTimerService.trigger(mWriteBackTimer); // 正在回写时跳过, 由下一次检查处理
+}
+
+void StorageManager::startTickMonitor() {
+    mTickMonitorAbortFlag = std::make_shared<std::atomic_bool>(false);
+    ll::coro::keepThis([this, abortFlag = mTickMonitorAbortFlag]() -> ll::coro::CoroTask<> {
+        constexpr int sampleTicks = 20;
+
+        auto last = std::chrono::steady_clock::now();
+        while (!abortFlag->load()) {
+            co_await ll::chrono::ticks(sampleTicks);
+            if (abortFlag->load()) {
+                break;
+            }
+            auto now = std::chrono::steady_clock::now();
+            auto avg = std::chrono::duration_cast<std::chrono::microseconds>(now - last) / sampleTicks;
+            last     = now;
+            mTickIntervalMicros.store(avg.count(), std::memory_order_relaxed);
         }
-    ).launch(threadPoolExecutor);
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
+void StorageManager::stopTickMonitor() {
+    if (mTickMonitorAbortFlag) {
+        mTickMonitorAbortFlag->store(true);
+        mTickMonitorAbortFlag = nullptr;
+    }
+}
+
+bool StorageManager::isUnderTickPressure() const {
+    return getTickInterval() > std::chrono::milliseconds{getConfig().storage.writeBack.tickPressureMs};
+}
+
+std::chrono::milliseconds StorageManager::getTickInterval() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::microseconds{mTickIntervalMicros.load(std::memory_order_relaxed)}
+    );
+}
+
+std::chrono::seconds StorageManager::getTimeSinceLastWriteBack() const {
+    std::lock_guard lock{mStatsMutex};
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - mLastWriteBackTime);
 }
 
 StorageManager::~StorageManager() {
-    mWriteBackTaskAbortFlag->store(true);
-    mInterruptableSleep->interrupt(true);
+    mTimerService.cancel(mWriteBackTimer);
+    stopTickMonitor();
+    stopMaintenance();
+}
+
+void StorageManager::enableLazyLoad() {
+    auto& bus = ll::event::EventBus::getInstance();
+    mLazyLoadListeners.emplace_back(
+        bus.emplaceListener<ll::event::PlayerJoinEvent>([this](ll::event::PlayerJoinEvent& ev) {
+            if (ev.self().isSimulatedPlayer()) {
+                return;
+            }
+            for (auto& [_, storage] : mStorages) {
+                storage->onPlayerJoin(ev.self().getRealName());
+            }
+        })
+    );
+    mLazyLoadListeners.emplace_back(
+        bus.emplaceListener<ll::event::PlayerDisconnectEvent>([this](ll::event::PlayerDisconnectEvent& ev) {
+            for (auto& [_, storage] : mStorages) {
+                storage->onPlayerDisconnect(ev.self().getRealName());
+            }
+        })
+    );
+}
+
+void StorageManager::disableLazyLoad() {
+    auto& bus = ll::event::EventBus::getInstance();
+    for (auto& listener : mLazyLoadListeners) {
+        bus.removeListener(listener);
+    }
+    mLazyLoadListeners.clear();
+}
+
+void StorageManager::startMaintenance() {
+    mMaintenanceTimer = mTimerService.scheduleEvery(std::chrono::seconds{30}, [this] {
+        for (auto& [_, storage] : mStorages) {
+            try {
+                storage->evictIdle();
+                storage->sweep();
+            } catch (const std::exception& e) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "StorageManager: Failed to maintain storage {}: {}",
+                    storage->getStorageName(),
+                    e.what()
+                );
+            }
+        }
+    });
+}
+
+void StorageManager::stopMaintenance() {
+    mTimerService.cancel(mMaintenanceTimer);
+    mMaintenanceTimer = TimerService::InvalidTimer;
 }
 
 void StorageManager::postLoad() {
-    for (auto& [_, storage] : mStorages) {
-        try {
-            storage->load();
-        } catch (const std::exception& e) {
-            TeleportSystem::getInstance().getSelf().getLogger().error(
-                "StorageManager: Failed to load storage: {}",
-                e.what()
+    try {
+        // 上次回写的批次未应用完成 (崩溃), 先补齐再重放更新的日志
+        if (auto count = StorageBatch::recover(*mDatabase); count > 0) {
+            TeleportSystem::getInstance().getSelf().getLogger().warn(
+                "StorageManager: Recovered {} entries of an interrupted write-back",
+                count
             );
-        } catch (...) {
-            TeleportSystem::getInstance().getSelf().getLogger().error(
-                "StorageManager: Failed to load storage: unknown error"
+        }
+    } catch (const std::exception& e) {
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "StorageManager: Failed to recover storage batch: {}",
+            e.what()
+        );
+    }
+
+    try {
+        // 重放上次未压缩的修改, 之后各 Storage 从数据库读取到的即是最新数据
+        if (auto count = mJournal->replay(*mDatabase); count > 0) {
+            mJournalReplayed = true;
+            TeleportSystem::getInstance().getSelf().getLogger().info(
+                "StorageManager: Replayed {} journal records",
+                count
             );
         }
+    } catch (const std::exception& e) {
+        mJournalReplayed = true;
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "StorageManager: Failed to replay journal: {}",
+            e.what()
+        );
+    }
+
+    loadStorages();
+
+    if (getConfig().storage.lazyLoad) {
+        enableLazyLoad();
+    }
+    startMaintenance();
+    startTickMonitor();
+}
+void StorageManager::loadStorages() {
+    auto& logger = TeleportSystem::getInstance().getSelf().getLogger();
+
+    std::unordered_map<std::string, IStorage*> storageMap;
+    for (auto& [_, storage] : mStorages) {
+        storageMap[storage->getStorageName()] = storage.get();
+    }
+
+    // 构建依赖图和入度表
+    std::unordered_map<std::string, std::vector<std::string>> graph;
+    std::unordered_map<std::string, int>                      inDegree;
+    for (auto& [name, storage] : storageMap) {
+        inDegree.try_emplace(name, 0);
+        for (auto& dep : storage->getDependencies()) {
+            if (!storageMap.contains(dep)) {
+                logger.warn("Storage {} depends on {}, but the dependency is not registered", name, dep);
+                continue;
+            }
+            graph[dep].push_back(name);
+            inDegree[name]++;
+        }
+    }
+
+    std::vector<std::string> wave;
+    for (auto& [name, degree] : inDegree) {
+        if (degree == 0) {
+            wave.push_back(name);
+        }
+    }
+
+    auto        totalStart = std::chrono::steady_clock::now();
+    std::size_t loaded     = 0;
+    while (!wave.empty()) {
+        // 同一层的 Storage 互不依赖, 提交到线程池并行加载, 全部完成后再加载下一层
+        std::latch latch{static_cast<std::ptrdiff_t>(wave.size())};
+        for (auto& name : wave) {
+            ll::coro::keepThis([&latch, &logger, storage = storageMap[name]]() -> ll::coro::CoroTask<> {
+                auto start = std::chrono::steady_clock::now();
+                try {
+                    storage->load();
+                    logger.info(
+                        "StorageManager: Loaded {} in {} ms",
+                        storage->getStorageName(),
+                        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+                            .count()
+                    );
+                } catch (const std::exception& e) {
+                    logger.error("StorageManager: Failed to load storage: {}", e.what());
+                } catch (...) {
+                    logger.error("StorageManager: Failed to load storage: unknown error");
+                }
+                latch.count_down();
+                co_return;
+            }).launch(mThreadPool);
+        }
+        latch.wait();
+        loaded += wave.size();
+
+        std::vector<std::string> next;
+        for (auto& name : wave) {
+            for (auto& dependent : graph[name]) {
+                if (--inDegree[dependent] == 0) {
+                    next.push_back(dependent);
+                }
+            }
+        }
+        wave = std::move(next);
+    }
+
+    // 存在循环依赖时按注册顺序串行加载剩余的 Storage
+    if (loaded != storageMap.size()) {
+        logger.error("Circular dependency detected in storages");
+        for (auto& [name, degree] : inDegree) {
+            if (degree <= 0) {
+                continue;
+            }
+            logger.error("Storage {} is part of a circular dependency", name);
+            try {
+                storageMap[name]->load();
+            } catch (const std::exception& e) {
+                logger.error("StorageManager: Failed to load storage: {}", e.what());
+            }
+        }
     }
+
+    logger.info(
+        "StorageManager: Loaded {} storages in {} ms",
+        storageMap.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - totalStart).count()
+    );
 }
+
 void StorageManager::postUnload() {
+    stopTickMonitor();
+    stopMaintenance();
+    disableLazyLoad();
+    postWriteBack();
+
     for (auto& [_, storage] : mStorages) {
         try {
             storage->unload();
@@ -68,22 +341,130 @@ void StorageManager::postUnload() {
         }
     }
 }
+
+void StorageManager::postConfigReload() {
+    for (auto& [_, storage] : mStorages) {
+        try {
+            storage->onConfigReload();
+        } catch (const std::exception& e) {
+            TeleportSystem::getInstance().getSelf().getLogger().error(
+                "StorageManager: Failed to reload storage config: {}",
+                e.what()
+            );
+        }
+    }
+}
+
+bool StorageManager::hasPendingWriteBack() const {
+    if (mJournal->getRecords() > 0) {
+        return true; // 上次回写失败或重放后尚未压缩
+    }
+    return std::ranges::any_of(mStorages, [](auto const& entry) { return entry.second->isDirty(); });
+}
+
 void StorageManager::postWriteBack() {
+    std::lock_guard lock{mWriteBackMutex};
+
+    // 没有任何修改时跳过轮转、提交与压缩, 上次回写时间也保持不变
+    if (!hasPendingWriteBack()) {
+        mSkippedWriteBackCount.fetch_add(mStorages.size(), std::memory_order_relaxed);
+        return;
+    }
+
+    // 先轮转日志再取快照: 轮转前的记录必然已发布到内存, 会被本次回写覆盖
+    bool compacting = true;
+    try {
+        mJournal->beginCompaction();
+    } catch (const std::exception& e) {
+        compacting = false;
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "StorageManager: Failed to rotate journal: {}",
+            e.what()
+        );
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    StorageBatch                                     batch;
+    std::vector<std::pair<IStorage*, std::uint64_t>> contributed; // 参与本次批次的 Storage 及其变更计数
+    bool                                             succeeded    = true;
+    auto                                             collectStart = Clock::now();
     for (auto& [_, storage] : mStorages) {
+        if (!storage->isDirty()) {
+            mSkippedWriteBackCount.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        auto mark = batch.mark();
         try {
-            storage->writeBack();
+            auto generation = storage->mGeneration.load(std::memory_order_acquire);
+            storage->writeBack(batch);
+            contributed.emplace_back(storage.get(), generation);
         } catch (const std::exception& e) {
+            succeeded = false;
+            batch.rollback(mark);
             TeleportSystem::getInstance().getSelf().getLogger().error(
                 "StorageManager: Failed to write back storage: {}",
                 e.what()
             );
         } catch (...) {
+            succeeded = false;
+            batch.rollback(mark);
             TeleportSystem::getInstance().getSelf().getLogger().error(
                 "StorageManager: Failed to write back storage: unknown error"
             );
         }
     }
+
+    auto commitStart = Clock::now();
+    try {
+        batch.commit(*mDatabase, contributed.size());
+        for (auto& [storage, generation] : contributed) {
+            storage->mFlushedGeneration = generation;
+        }
+        mWriteBackCount.fetch_add(contributed.size(), std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        succeeded = false;
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "StorageManager: Failed to commit storage batch: {}",
+            e.what()
+        );
+    }
+    auto commitEnd = Clock::now();
+
+    std::lock_guard statsLock{mStatsMutex};
+    mLastWriteBackTime = commitEnd;
+    if (!contributed.empty()) {
+        mLastWriteBackStats = {
+            .collectTime = std::chrono::duration_cast<std::chrono::microseconds>(commitStart - collectStart),
+            .commitTime  = std::chrono::duration_cast<std::chrono::microseconds>(commitEnd - commitStart),
+            .storages    = contributed.size(),
+            .operations  = batch.size(),
+            .bytes       = batch.getBytes(),
+        };
+    }
+
+    // 任一 Storage 回写失败时保留日志, 下次回写或启动时重放
+    if (compacting && succeeded) {
+        mJournal->commitCompaction();
+    }
 }
 
+std::uint64_t StorageManager::getWriteBackCount() const { return mWriteBackCount.load(std::memory_order_relaxed); }
+std::uint64_t StorageManager::getSkippedWriteBackCount() const {
+    return mSkippedWriteBackCount.load(std::memory_order_relaxed);
+}
+std::uint64_t StorageManager::getDeferredWriteBackCount() const {
+    return mDeferredWriteBackCount.load(std::memory_order_relaxed);
+}
+
+StorageManager::WriteBackStats StorageManager::getLastWriteBackStats() const {
+    std::lock_guard lock{mStatsMutex};
+    return mLastWriteBackStats;
+}
+
+StorageJournal const& StorageManager::getJournal() const { return *mJournal; }
+
+PlayerRegistry& StorageManager::getPlayerRegistry() const { return *mPlayerRegistry; }
+
 
 } // namespace ltps
\ No newline at end of file
@@ -1,26 +1,82 @@
 #pragma once
 #include "ll/api/data/KeyValueDB.h"
+#include "ll/api/event/ListenerBase.h"
 #include "ll/api/thread/ThreadPoolExecutor.h"
 #include "ltps/Global.h"
+#include "ltps/common/TimerService.h"
 #include "ltps/database/IStorage.h"
-#include <ll/api/coro/InterruptableSleep.h>
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/database/StorageJournal.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 
 namespace ltps {
 
 class StorageManager final {
+public:
+    struct WriteBackStats {
+        std::chrono::microseconds collectTime{0}; // 各 Storage 编码修改耗时
+        std::chrono::microseconds commitTime{0};  // 批次提交到数据库耗时
+        std::size_t               storages{0};    // 参与回写的 Storage 数量
+        std::size_t               operations{0};  // 写入/删除的键数量
+        std::size_t               bytes{0};       // 写入的字节数
+    };
+
+    enum class WriteBackReason {
+        MaxInterval, // 达到最长回写间隔
+        Threshold,   // 待回写修改数或数据量达到阈值
+        Requested,   // 手动请求 (/ltps flush)
+    };
+
 private:
+    ll::thread::ThreadPoolExecutor&                                mThreadPool;
+    TimerService&                                                  mTimerService;
     std::unique_ptr<ll::data::KeyValueDB>                          mDatabase;
+    std::unique_ptr<StorageJournal>                                mJournal; // 预写日志, 回写成功后压缩
     std::unordered_map<std::type_index, std::unique_ptr<IStorage>> mStorages;
-    std::shared_ptr<ll::coro::InterruptableSleep>                  mInterruptableSleep{nullptr};
-    std::shared_ptr<std::atomic_bool>                              mWriteBackTaskAbortFlag{nullptr};
+    PlayerRegistry*                                                mPlayerRegistry{nullptr}; // 始终注册, 见构造函数
+    TimerService::TimerId                                          mWriteBackTimer{TimerService::InvalidTimer};
+    std::atomic<std::uint64_t>                                     mWriteBackCount{0};          // 实际回写次数
+    std::atomic<std::uint64_t>                                     mSkippedWriteBackCount{0};   // 无变更跳过次数
+    std::atomic<std::uint64_t>                                     mDeferredWriteBackCount{0};  // 负载过高推迟次数
+    std::atomic_bool                                               mWriteBackRequested{false};
+    std::atomic<std::int64_t>                                      mTickIntervalMicros{50'000}; // 最近的平均 tick 间隔
+    std::shared_ptr<std::atomic_bool>                              mTickMonitorAbortFlag{nullptr};
+    std::chrono::steady_clock::time_point                          mLastWriteBackTime;
+    std::mutex                                                     mWriteBackMutex;             // 串行化回写
+    WriteBackStats                                                 mLastWriteBackStats{};
+    mutable std::mutex                                             mStatsMutex;                 // 保护回写统计与时间
+    std::vector<ll::event::ListenerPtr>                            mLazyLoadListeners;          // 按需加载监听
+    TimerService::TimerId                                          mMaintenanceTimer{TimerService::InvalidTimer};
+    bool                                                           mJournalReplayed{false};     // 本次启动重放过日志
+
+
+    explicit StorageManager(ll::thread::ThreadPoolExecutor& threadPoolExecutor, TimerService& timerService);
+
+    void enableLazyLoad(); // 注册进服/离线监听
+    void disableLazyLoad();
+
+    void startMaintenance(); // 定期在服务器线程淘汰空闲玩家 (按需加载) 并增量清理过期记录
+    void stopMaintenance();
+
+    void loadStorages(); // 按依赖分层, 同层 Storage 在线程池中并行加载
+
+    void startTickMonitor(); // 在服务器线程统计平均 tick 间隔
+    void stopTickMonitor();
 
+    std::optional<WriteBackReason> pollWriteBack(); // 按回写策略判断当前是否需要回写
 
-    explicit StorageManager(ll::thread::ThreadPoolExecutor& threadPoolExecutor);
+    bool hasPendingWriteBack() const; // 有待回写的 Storage 或未压缩的日志记录, 调用方须持有 mWriteBackMutex
 
     friend IStorage;
     friend class TeleportSystem;
@@ -32,7 +88,27 @@ class StorageManager final {
 
     TPSAPI void postLoad();      // 通知所有Storage实例加载
     TPSAPI void postUnload();    // 通知所有Storage实例卸载
-    TPSAPI void postWriteBack(); // 通知所有Storage实例回写
+    TPSAPI void postWriteBack(); // 通知所有Storage实例回写 (跳过无变更的实例), 合并为一个批次原子提交
+
+    TPSAPI void postConfigReload(); // 通知所有Storage实例配置已重载
+
+    TPSNDAPI std::uint64_t getWriteBackCount() const;
+    TPSNDAPI std::uint64_t getSkippedWriteBackCount() const;
+    TPSNDAPI std::uint64_t getDeferredWriteBackCount() const;
+
+    TPSAPI void requestWriteBack(); // 请求立即检查回写 (不阻塞调用方)
+
+    TPSNDAPI bool isUnderTickPressure() const;
+
+    TPSNDAPI std::chrono::milliseconds getTickInterval() const;
+
+    TPSNDAPI std::chrono::seconds getTimeSinceLastWriteBack() const;
+
+    TPSNDAPI WriteBackStats getLastWriteBackStats() const;
+
+    TPSNDAPI StorageJournal const& getJournal() const;
+
+    TPSNDAPI PlayerRegistry& getPlayerRegistry() const;
 
     // 注册一个Storage实例
     template <typename T, typename... Args>
@@ -2,6 +2,9 @@
 
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/utils/BinaryUtils.h"
+#include "ltps/utils/JsonSaxReader.h"
 #include "ltps/utils/JsonUtls.h"
 #include "ltps/utils/TimeUtils.h"
 
@@ -9,108 +12,655 @@
 #include <mc/world/actor/player/Player.h>
 #include <mc/world/level/dimension/VanillaDimensions.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 namespace ltps ::death {
 
+namespace {
+
+using DeathSaxReader = json_utils::RecordSaxReader<DeathStorage::DeathInfo>;
+
+void assignDeathField(DeathStorage::DeathInfo& info, std::string_view field, DeathSaxReader::Value const& value) {
+    if (field == "time") {
+        json_utils::assignEpoch(info.time, value);
+    } else if (field == "x") {
+        json_utils::assignNumber(info.x, value);
+    } else if (field == "y") {
+        json_utils::assignNumber(info.y, value);
+    } else if (field == "z") {
+        json_utils::assignNumber(info.z, value);
+    } else if (field == "dimid") {
+        json_utils::assignNumber(info.dimid, value);
+    }
+}
+
+} // namespace
+
 
 DeathStorage::DeathStorage() = default;
 
+std::vector<std::string> DeathStorage::getDependencies() const { return {PlayerRegistry::name}; }
+
 void DeathStorage::load() {
-    auto& db = getDatabase();
+    if (getDatabase().has(STORAGE_KEY)) {
+        migrateLegacyDeathInfos();
+    }
 
-    if (!db.has(STORAGE_KEY)) {
-        db.set(STORAGE_KEY, "{}");
+    mDeathInfoMap.setLazy(getConfig().storage.lazyLoad);
+
+    // 按需加载模式下只读取概要, 记录本身在访问时再加载; 概要不可用时在后台重建
+    if (mDeathInfoMap.isLazy()) {
+        if (loadRetention()) {
+            TeleportSystem::getInstance().getSelf().getLogger().info(
+                "Death infos will be loaded on demand, indexed {} players",
+                mRetention.size()
+            );
+            return;
+        }
+        TeleportSystem::getInstance().getSelf().getLogger().info(
+            "Death infos will be loaded on demand, rebuilding retention summary in background"
+        );
+        rebuildRetentionAsync();
+        return;
     }
 
-    auto rawJson = db.get(STORAGE_KEY);
-    if (!rawJson) {
-        throw std::runtime_error("Could not load death data");
+    auto capacity = getCapacity();
+    forEachWithPrefix(KEY_PREFIX, [this, capacity](std::string_view realName, std::string_view value) {
+        try {
+            auto id    = getPlayerRegistry().intern(RealName{realName});
+            auto infos = decodeDeathInfos(value, capacity);
+            updateRetention(id, &infos);
+            mDeathInfoMap.emplaceClean(id, std::move(infos));
+        } catch (const std::exception& e) {
+            throw std::runtime_error(
+                "Could not parse death data of player: " + std::string{realName} + ", " + e.what()
+            );
+        }
+    });
+
+    // 概要与记录不一致 (升级或崩溃后) 时在下次回写中重写, 供切换到按需加载模式时使用
+    {
+        std::lock_guard lock{mRetentionMutex};
+        auto            stored = getDatabase().get(SUMMARY_KEY);
+        mRetentionDirty        = !stored || *stored != encodeRetention();
+        if (mRetentionDirty) {
+            markDirty();
+        }
     }
+    TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} death infos", mDeathInfoMap.size());
+}
 
+void DeathStorage::unload() {
+    mDeathInfoMap.setLazy(false); // 丢弃尚未完成的异步加载
+    mDeathInfoMap.clear();
+    ++mLoadGeneration;
+    mSweepPending = false;
+
+    std::lock_guard lock{mRetentionMutex};
+    mRetention.clear();
+    mByOldest.clear();
+    mByNewest.clear();
+    mTotalDeathInfos = 0;
+    mRetentionDirty  = false;
+}
+
+void DeathStorage::writeBack(StorageBatch& batch) {
+    auto& registry = getPlayerRegistry();
+    auto  snapshot = mDeathInfoMap.takeDirtySnapshot();
+    bool  summary  = false; // 本批次包含概要
     try {
-        auto json = nlohmann::json::parse(rawJson.value());
-        if (!json.is_object()) {
-            throw std::runtime_error("Could not parse death data");
+        for (auto const& [id, infos] : snapshot) {
+            auto const& realName = registry.getName(id);
+            if (!infos || infos->empty()) {
+                batch.del(makePlayerKey(realName));
+                continue;
+            }
+            batch.set(makePlayerKey(realName), encodeDeathInfos(*infos));
         }
 
-        json_utils::json2structTryPatch(mDeathInfoMap, json);
-        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} death infos", mDeathInfoMap.size());
-    } catch (const nlohmann::json::parse_error& e) {
-        throw std::runtime_error("Could not parse death data");
+        std::lock_guard lock{mRetentionMutex};
+        if (mRetentionDirty) {
+            batch.set(SUMMARY_KEY, encodeRetention());
+            mRetentionDirty = false;
+            summary         = true;
+        }
+    } catch (...) {
+        mDeathInfoMap.markDirty(snapshot);
+        throw;
     }
+    batch.onComplete([this, summary, snapshot = std::move(snapshot)](bool succeeded) {
+        succeeded ? mDeathInfoMap.commitSnapshot() : mDeathInfoMap.markDirty(snapshot);
+        if (!succeeded && summary) {
+            std::lock_guard lock{mRetentionMutex};
+            mRetentionDirty = true;
+        }
+    });
 }
 
-void DeathStorage::unload() { writeBack(); }
+void DeathStorage::onPlayerJoin(RealName const& realName) {
+    auto id = getPlayerRegistry().intern(realName);
+    mDeathInfoMap.setOnline(id, true);
+    if (mDeathInfoMap.contains(id)) {
+        return;
+    }
+    dispatchAsync([this, realName, id, epoch = mDeathInfoMap.getEvictionEpoch()]() -> std::function<void()> {
+        auto infos = readDeathInfos(realName);
+        if (!infos) {
+            return nullptr;
+        }
+        return [this, id, epoch, infos = std::move(*infos)]() mutable {
+            mDeathInfoMap.emplaceLoaded(id, std::move(infos), epoch);
+        };
+    });
+}
 
-void DeathStorage::writeBack() {
-    auto& db   = getDatabase();
-    auto  json = json_utils::struct2json(mDeathInfoMap);
-    db.set(STORAGE_KEY, json.dump());
+void DeathStorage::onPlayerDisconnect(RealName const& realName) {
+    if (auto id = getPlayerRegistry().find(realName)) {
+        mDeathInfoMap.setOnline(*id, false);
+    }
 }
 
-bool DeathStorage::hasDeathInfo(RealName const& realName) const {
-    return mDeathInfoMap.contains(realName) && !mDeathInfoMap.at(realName).empty();
+void DeathStorage::evictIdle() {
+    auto& cfg = getConfig().storage;
+    mDeathInfoMap.evictIdle(static_cast<std::size_t>(cfg.cacheCapacity), std::chrono::seconds{cfg.evictDelay});
 }
 
-void DeathStorage::addDeathInfo(RealName const& realName, DeathInfo deathInfo) {
-    if (!hasDeathInfo(realName)) {
-        mDeathInfoMap[realName] = {};
+void DeathStorage::onConfigReload() {
+    auto capacity = getCapacity();
+
+    std::vector<PlayerId> changed;
+    for (auto const& [id, infos] : mDeathInfoMap.records()) {
+        if (infos->capacity() != capacity) {
+            changed.push_back(id);
+        }
+    }
+    for (auto id : changed) {
+        auto infos     = *mDeathInfoMap.find(id); // 写时复制
+        auto truncated = infos.size() > capacity;
+        infos.resize(capacity);
+        if (!truncated) {
+            mDeathInfoMap.emplaceClean(id, std::move(infos)); // 内容未变, 无需回写
+            continue;
+        }
+        auto const& realName = getPlayerRegistry().getName(id);
+        mDeathInfoMap.set(id, std::move(infos));
+        markDirty();
+        journalSet(makePlayerKey(realName), encodeDeathInfos(*mDeathInfoMap.find(id)));
+        updateRetention(id, mDeathInfoMap.find(id));
     }
-    auto& deathInfos = mDeathInfoMap[realName];
-    deathInfos.insert(deathInfos.begin(), std::move(deathInfo)); // 插入到最前面
+}
 
-    if (deathInfos.size() > getConfig().modules.death.maxDeathInfos) {
-        deathInfos.pop_back(); // 删除最后一个
+void DeathStorage::sweep() {
+    if (mSweepPending) {
+        return; // 上一轮仍在读取记录
     }
+    auto plan = planSweep();
+    if (plan.expired.empty() && plan.overflow.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<PlayerId, RealName>> uncached;
+    if (mDeathInfoMap.isLazy()) {
+        for (auto const& ids : {std::cref(plan.expired), std::cref(plan.overflow)}) {
+            for (auto id : ids.get()) {
+                if (!mDeathInfoMap.contains(id) && !mDeathInfoMap.isPending(id)) {
+                    uncached.emplace_back(id, getPlayerRegistry().getName(id));
+                }
+            }
+        }
+    }
+    if (uncached.empty()) {
+        applySweep(plan);
+        return;
+    }
+
+    // 在线程池读取并解码未缓存的记录, 服务器线程只负责发布结果与删除
+    mSweepPending   = true;
+    auto generation = mLoadGeneration;
+    auto epoch      = mDeathInfoMap.getEvictionEpoch();
+    dispatchAsync([this, generation, epoch, plan, uncached = std::move(uncached)]() -> std::function<void()> {
+        std::vector<std::pair<PlayerId, std::optional<DeathInfos>>> loaded;
+        loaded.reserve(uncached.size());
+        try {
+            for (auto const& [id, realName] : uncached) {
+                loaded.emplace_back(id, readDeathInfos(realName));
+            }
+        } catch (const std::exception& e) {
+            TeleportSystem::getInstance().getSelf().getLogger().error(
+                "DeathStorage: Failed to read death infos for sweep: {}",
+                e.what()
+            );
+            return [this, generation] {
+                if (generation == mLoadGeneration) {
+                    mSweepPending = false; // 下一轮重试
+                }
+            };
+        }
+        return [this, generation, epoch, plan, loaded = std::move(loaded)]() mutable {
+            if (generation != mLoadGeneration) {
+                return; // 已卸载或已重新加载
+            }
+            mSweepPending = false;
+            for (auto& [id, infos] : loaded) {
+                if (infos) {
+                    mDeathInfoMap.emplaceLoaded(id, std::move(*infos), epoch);
+                } else if (!mDeathInfoMap.contains(id) && !mDeathInfoMap.isPending(id)) {
+                    updateRetention(id, nullptr); // 数据库中已没有该玩家的记录
+                }
+            }
+            applySweep(plan);
+        };
+    });
 }
 
-DeathStorage::DeathInfos const* DeathStorage::getDeathInfos(RealName const& realName) const {
-    if (!hasDeathInfo(realName)) {
+DeathStorage::SweepPlan DeathStorage::planSweep() const {
+    auto const& cfg    = getConfig().modules.death;
+    std::size_t budget = SWEEP_BATCH;
+    SweepPlan   plan;
+
+    if (cfg.retentionDays > 0) {
+        plan.cutoff = time_utils::getCurrentEpoch() - static_cast<std::int64_t>(cfg.retentionDays) * 24 * 60 * 60;
+        for (auto const& [oldest, id] : mByOldest) {
+            if (budget == 0 || oldest >= plan.cutoff) {
+                break;
+            }
+            plan.expired.push_back(id);
+            --budget;
+        }
+    }
+
+    if (cfg.maxTotalDeathInfos > 0) {
+        plan.cap       = static_cast<std::size_t>(cfg.maxTotalDeathInfos);
+        auto projected = mTotalDeathInfos;
+        for (auto const& [newest, id] : mByNewest) {
+            if (budget == 0 || projected <= plan.cap) {
+                break;
+            }
+            plan.overflow.push_back(id);
+            projected -= mRetention.at(id).count;
+            --budget;
+        }
+    }
+    return plan;
+}
+
+void DeathStorage::applySweep(SweepPlan const& plan) {
+    auto cached = [this](PlayerId id) {
+        return !mDeathInfoMap.isLazy() || mDeathInfoMap.contains(id) || mDeathInfoMap.isPending(id);
+    };
+
+    std::size_t swept = 0;
+    for (auto id : plan.expired) {
+        auto iter = mRetention.find(id);
+        if (iter == mRetention.end() || iter->second.oldest >= plan.cutoff || !cached(id)) {
+            continue; // 期间已被修改、删除或淘汰
+        }
+        expireDeathInfos(id, plan.cutoff);
+        ++swept;
+    }
+    for (auto id : plan.overflow) {
+        if (mTotalDeathInfos <= plan.cap) {
+            break;
+        }
+        if (!mRetention.contains(id) || !cached(id)) {
+            continue;
+        }
+        removeDeathInfos(id, getPlayerRegistry().getName(id));
+        ++swept;
+    }
+
+    if (swept > 0) {
+        TeleportSystem::getInstance().getSelf().getLogger().debug(
+            "DeathStorage: Swept {} players, {} death infos remaining",
+            swept,
+            mTotalDeathInfos
+        );
+    }
+}
+
+std::size_t DeathStorage::getTotalDeathInfos() const { return mTotalDeathInfos; }
+
+void DeathStorage::updateRetention(PlayerId id, DeathInfos const* infos) {
+    setRetention(id, infos && !infos->empty() ? std::optional{makeRetention(*infos)} : std::nullopt);
+}
+
+void DeathStorage::setRetention(PlayerId id, std::optional<Retention> retention) {
+    std::lock_guard lock{mRetentionMutex};
+    mRetentionDirty = true;
+    if (auto iter = mRetention.find(id); iter != mRetention.end()) {
+        auto const& old = iter->second;
+        mByOldest.erase({old.oldest, id});
+        mByNewest.erase({old.newest, id});
+        mTotalDeathInfos -= old.count;
+        mRetention.erase(iter);
+    }
+    if (!retention) {
+        return;
+    }
+    mByOldest.emplace(retention->oldest, id);
+    mByNewest.emplace(retention->newest, id);
+    mTotalDeathInfos += retention->count;
+    mRetention.emplace(id, *retention);
+}
+
+DeathStorage::Retention DeathStorage::makeRetention(DeathInfos const& infos) {
+    return Retention{infos.back().time, infos.front().time, static_cast<std::uint32_t>(infos.size())};
+}
+
+// v1: [header][count: varint] { [realName: string][oldest: i64][newest: i64][records: varint] } * count
+std::string DeathStorage::encodeRetention() const {
+    auto&                registry = getPlayerRegistry();
+    binary_utils::Writer writer{8 + mRetention.size() * 32};
+    writer.writeHeader(SUMMARY_VERSION).writeVarUInt(mByNewest.size());
+    for (auto const& [newest, id] : mByNewest) {
+        auto const& retention = mRetention.at(id);
+        writer.writeString(registry.getName(id)).writeI64(retention.oldest).writeI64(newest);
+        writer.writeVarUInt(retention.count);
+    }
+    return writer.release();
+}
+
+bool DeathStorage::loadRetention() {
+    if (isRecoveredFromJournal()) {
+        return false; // 重放的日志可能修改了记录, 概要不再可信
+    }
+    auto value = getDatabase().get(SUMMARY_KEY);
+    if (!value) {
+        return false; // 升级后首次启动
+    }
+
+    std::vector<std::pair<RealName, Retention>> entries;
+    try {
+        binary_utils::Reader reader{*value};
+        if (reader.readHeader() != SUMMARY_VERSION) {
+            return false;
+        }
+        auto count = reader.readVarUInt();
+        for (std::uint64_t i = 0; i < count; ++i) {
+            auto realName = reader.readString();
+            auto oldest   = reader.readI64();
+            auto newest   = reader.readI64();
+            auto records  = static_cast<std::uint32_t>(reader.readVarUInt());
+            entries.emplace_back(std::move(realName), Retention{oldest, newest, records});
+        }
+    } catch (const std::exception& e) {
+        TeleportSystem::getInstance().getSelf().getLogger().warn(
+            "Could not parse death retention summary: {}",
+            e.what()
+        );
+        return false;
+    }
+
+    for (auto& [realName, retention] : entries) {
+        setRetention(getPlayerRegistry().intern(realName), retention);
+    }
+    std::lock_guard lock{mRetentionMutex};
+    mRetentionDirty = false; // 与数据库中的概要一致
+    return true;
+}
+
+void DeathStorage::rebuildRetentionAsync() {
+    dispatchAsync([this, capacity = getCapacity(), generation = mLoadGeneration]() -> std::function<void()> {
+        std::vector<std::pair<RealName, Retention>> entries;
+        forEachWithPrefix(KEY_PREFIX, [&](std::string_view realName, std::string_view value) {
+            try {
+                auto infos = decodeDeathInfos(value, capacity);
+                if (!infos.empty()) {
+                    entries.emplace_back(RealName{realName}, makeRetention(infos));
+                }
+            } catch (const std::exception& e) {
+                TeleportSystem::getInstance().getSelf().getLogger().error(
+                    "Could not parse death data of player: {}, {}",
+                    realName,
+                    e.what()
+                );
+            }
+        });
+
+        return [this, generation, entries = std::move(entries)] {
+            if (generation != mLoadGeneration || !mDeathInfoMap.isLazy()) {
+                return; // 已卸载或已重新加载
+            }
+            for (auto const& [realName, retention] : entries) {
+                auto id = getPlayerRegistry().intern(realName);
+                if (mRetention.contains(id)) {
+                    continue; // 重建期间已随记录更新
+                }
+                if (mDeathInfoMap.contains(id) || mDeathInfoMap.isPending(id)) {
+                    updateRetention(id, mDeathInfoMap.find(id)); // 已缓存的记录比扫描结果新
+                    continue;
+                }
+                setRetention(id, retention);
+            }
+            markDirty(); // 下次回写时保存概要
+            TeleportSystem::getInstance().getSelf().getLogger().info(
+                "Rebuilt death retention summary of {} players",
+                mRetention.size()
+            );
+        };
+    });
+}
+
+void DeathStorage::removeDeathInfos(PlayerId id, RealName const& realName) {
+    findDeathInfos(realName); // 按需加载模式下先载入, 使删除能够回写
+    mDeathInfoMap.erase(id);
+    markDirty();
+    journalDel(makePlayerKey(realName));
+    updateRetention(id, nullptr);
+}
+
+void DeathStorage::expireDeathInfos(PlayerId id, std::int64_t cutoff) {
+    auto const& realName = getPlayerRegistry().getName(id);
+    auto        current  = findDeathInfos(realName);
+    if (!current) {
+        updateRetention(id, nullptr); // 数据库中已没有该玩家的记录
+        return;
+    }
+    auto infos = *current; // 写时复制
+    while (!infos.empty() && infos.back().time < cutoff) {
+        infos.pop_back();
+    }
+    if (infos.empty()) {
+        removeDeathInfos(id, realName);
+        return;
+    }
+    mDeathInfoMap.set(id, std::move(infos));
+    markDirty();
+    journalSet(makePlayerKey(realName), encodeDeathInfos(*mDeathInfoMap.find(id)));
+    updateRetention(id, mDeathInfoMap.find(id));
+}
+
+std::size_t DeathStorage::getCapacity() {
+    return static_cast<std::size_t>(std::max(getConfig().modules.death.maxDeathInfos, 0));
+}
+
+std::optional<DeathStorage::DeathInfos> DeathStorage::readDeathInfos(RealName const& realName) const {
+    auto value = getDatabase().get(makePlayerKey(realName));
+    if (!value) {
+        return std::nullopt;
+    }
+    try {
+        return decodeDeathInfos(*value, getCapacity());
+    } catch (const std::exception& e) {
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "Could not parse death data of player: {}, {}",
+            realName,
+            e.what()
+        );
+        return std::nullopt;
+    }
+}
+
+DeathStorage::DeathInfos const* DeathStorage::findDeathInfos(RealName const& realName) const {
+    auto id = findPlayerId(realName, makePlayerKey(realName), mDeathInfoMap.isLazy());
+    if (!id) {
         return nullptr;
     }
-    return &mDeathInfoMap.at(realName);
+    mDeathInfoMap.ensureLoaded(*id, [&] { return readDeathInfos(realName); });
+    return mDeathInfoMap.find(*id);
+}
+
+std::string DeathStorage::makePlayerKey(RealName const& realName) { return KEY_PREFIX + realName; }
+
+// v1: [header][count: varint] { [x, y, z: f32][dimid: i32][time] } * count
+// v2: 同 v1, 但 time 为 i64 Unix 时间戳
+std::string DeathStorage::encodeDeathInfos(DeathInfos const& infos) {
+    binary_utils::Writer writer{8 + infos.size() * 24};
+    writer.writeHeader(BINARY_VERSION).writeVarUInt(infos.size());
+    for (auto const& info : infos) {
+        writer.writeF32(info.x).writeF32(info.y).writeF32(info.z).writeI32(info.dimid).writeI64(info.time);
+    }
+    return writer.release();
+}
+
+void DeathStorage::migrateLegacyDeathInfos() {
+    auto& db     = getDatabase();
+    auto  legacy = db.get(STORAGE_KEY);
+    if (!legacy) {
+        return;
+    }
+
+    // 先写入新键，全部成功后再删除旧键，中途失败时下次启动会重新迁移
+    std::size_t count = 0;
+    try {
+        readLegacyDeathInfos(*legacy, [&](std::string_view realName, DeathRecords records) {
+            if (records.empty()) {
+                return;
+            }
+            DeathInfos infos{records.size()}; // 迁移时保留全部记录, 加载时再按上限截断
+            for (auto& info : records) {
+                infos.push_back(info);
+            }
+            if (!db.set(makePlayerKey(RealName{realName}), encodeDeathInfos(infos))) {
+                throw std::runtime_error("Could not write death data of player: " + std::string{realName});
+            }
+            ++count;
+        });
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string{"Could not migrate legacy death data, "} + e.what());
+    }
+    db.del(STORAGE_KEY);
+
+    TeleportSystem::getInstance().getSelf().getLogger().info("Migrated legacy death data of {} players", count);
+}
+
+void DeathStorage::readLegacyDeathInfos(
+    std::string_view                                                          data,
+    std::function<void(std::string_view realName, DeathRecords infos)> const& fn
+) {
+    DeathSaxReader{DeathSaxReader::Layout::ObjectOfArrays, assignDeathField, fn}.parse(data);
+}
+
+DeathStorage::DeathInfos DeathStorage::decodeDeathInfos(std::string_view data, std::size_t capacity) {
+    DeathInfos infos{capacity};
+    if (!binary_utils::isBinary(data)) {
+        // 旧版 JSON 数据, 流式解析不构建 DOM
+        auto onRecords = [&](std::string_view, DeathRecords records) {
+            for (auto& info : records) {
+                if (!infos.push_back(info)) {
+                    break;
+                }
+            }
+        };
+        DeathSaxReader{DeathSaxReader::Layout::Array, assignDeathField, onRecords}.parse(data);
+        return infos;
+    }
+
+    binary_utils::Reader reader{data};
+    auto                 version = reader.readHeader();
+    if (version != 1 && version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported death data version: " + std::to_string(version));
+    }
+    auto count = reader.readVarUInt();
+    for (std::uint64_t i = 0; i < count && !infos.full(); ++i) { // 记录从新到旧, 超出容量的旧记录无需读取
+        DeathInfo info{};
+        info.x     = reader.readF32();
+        info.y     = reader.readF32();
+        info.z     = reader.readF32();
+        info.dimid = reader.readI32();
+        info.time  = version == 1 ? time_utils::parseEpoch(reader.readString()) : reader.readI64();
+        infos.push_back(info);
+    }
+    return infos;
+}
+
+bool DeathStorage::hasDeathInfo(RealName const& realName) const {
+    auto infos = findDeathInfos(realName);
+    return infos && !infos->empty();
+}
+
+void DeathStorage::addDeathInfo(RealName const& realName, DeathInfo deathInfo) {
+    auto current    = findDeathInfos(realName);
+    auto deathInfos = current ? *current : DeathInfos{getCapacity()}; // 写时复制
+    deathInfos.resize(getCapacity());                                  // 重载配置期间异步加载的记录可能仍是旧容量
+    deathInfos.push_front(deathInfo);                                  // 已满时覆盖最旧的一条
+
+    auto id = getPlayerRegistry().intern(realName);
+    mDeathInfoMap.set(id, std::move(deathInfos));
+    markDirty();
+    journalSet(makePlayerKey(realName), encodeDeathInfos(*mDeathInfoMap.find(id)));
+    updateRetention(id, mDeathInfoMap.find(id));
+}
+
+DeathStorage::DeathInfos const* DeathStorage::getDeathInfos(RealName const& realName) const {
+    auto infos = findDeathInfos(realName);
+    return infos && !infos->empty() ? infos : nullptr;
 }
 
 std::optional<DeathStorage::DeathInfo> DeathStorage::getLatestDeathInfo(RealName const& realName) const {
-    if (!hasDeathInfo(realName)) {
+    auto infos = getDeathInfos(realName);
+    if (!infos) {
         return std::nullopt;
     }
-    return mDeathInfoMap.at(realName).front();
+    return infos->front();
 }
 
 std::optional<DeathStorage::DeathInfo> DeathStorage::getSpecificDeathInfo(RealName const& realName, int index) const {
-    if (!hasDeathInfo(realName)) {
+    auto infos = getDeathInfos(realName);
+    if (!infos) {
         return std::nullopt;
     }
 
-    auto& deathInfos = mDeathInfoMap.at(realName);
-    if (index < 0 || index >= deathInfos.size()) {
+    if (index < 0 || static_cast<std::size_t>(index) >= infos->size()) {
         return std::nullopt; // 索引超出范围
     }
-    return deathInfos[index];
+    return (*infos)[static_cast<std::size_t>(index)];
 }
 
 
 bool DeathStorage::clearDeathInfo(RealName const& realName) {
-    if (!hasDeathInfo(realName)) {
+    auto id = getPlayerRegistry().find(realName);
+    if (!id || !hasDeathInfo(realName)) {
         return false;
     }
-    mDeathInfoMap.erase(realName);
+    removeDeathInfos(*id, realName);
     return true;
 }
 
 
 DeathStorage::DeathInfo DeathStorage::DeathInfo::make(Vec3 const& pos, int dimid) {
-    return {.time = time_utils::getCurrentTimeString(), .x = pos.x, .y = pos.y, .z = pos.z, .dimid = dimid};
+    return {.time = time_utils::getCurrentEpoch(), .x = pos.x, .y = pos.y, .z = pos.z, .dimid = dimid};
 }
 
 void DeathStorage::DeathInfo::teleport(Player& player) const {
     player.teleport(Vec3(x, y, z), dimid, player.getRotation());
 }
 
-std::string DeathStorage::DeathInfo::toString() const { return "{} => {}"_tr(time, toPosString()); }
+std::string DeathStorage::DeathInfo::toString() const { return "{} => {}"_tr(getTimeString(), toPosString()); }
 std::string DeathStorage::DeathInfo::toPosString() const {
     return "{}({},{},{})"_tr(VanillaDimensions::toString(dimid), x, y, z);
 }
+std::string DeathStorage::DeathInfo::getTimeString() const { return time_utils::epochToString(time); }
 
 
 } // namespace ltps::death
\ No newline at end of file
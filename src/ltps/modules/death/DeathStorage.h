@@ -1,5 +1,18 @@
 #pragma once
+#include "ltps/common/RingBuffer.h"
+#include "ltps/database/PlayerRecordCache.h"
 #include "ltps/database/IStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 class Vec3;
@@ -10,9 +23,9 @@ namespace ltps ::death {
 class DeathStorage final : public IStorage {
 public:
     struct DeathInfo {
-        std::string time;    // 死亡时间
-        float       x, y, z; // 死亡位置
-        int         dimid;   // 维度ID
+        std::int64_t time;    // 死亡时间 (Unix 时间戳, 秒)
+        float        x, y, z; // 死亡位置
+        int          dimid;   // 维度ID
 
         TPSNDAPI static DeathInfo make(Vec3 const& pos, int dimid);
 
@@ -20,21 +33,89 @@ class DeathStorage final : public IStorage {
 
         TPSNDAPI std::string toString() const;
         TPSNDAPI std::string toPosString() const;
+        TPSNDAPI std::string getTimeString() const; // 格式化为本地时间, 仅用于显示
     };
-    using DeathInfos   = std::vector<DeathInfo>;
-    using DeathInfoMap = std::unordered_map<RealName, DeathInfos>;
+    using DeathInfos   = RingBuffer<DeathInfo>; // 容量为 maxDeathInfos, 下标 0 为最近一次死亡
+    using DeathRecords = std::vector<DeathInfo>; // 旧版 JSON 数据的解析结果, 从新到旧
+    using DeathInfoMap = PlayerRecordCache<DeathInfos>::Map;
 
 private:
-    DeathInfoMap mDeathInfoMap;
+    // 每位玩家死亡记录的概要, 不随按需加载淘汰, 用于保留策略的增量清理
+    // 随回写保存在 SUMMARY_KEY 中, 按需加载模式下启动时只读取概要, 无需解码全部记录
+    struct Retention {
+        std::int64_t  oldest; // 最早一条记录的时间
+        std::int64_t  newest; // 最近一次死亡的时间, 视为最近活跃时间
+        std::uint32_t count;
+    };
+    using TimeIndex = std::set<std::pair<std::int64_t, PlayerId>>;
+
+    // 一轮清理选出的玩家; 按需加载模式下未缓存的记录先在线程池读取, 再回到服务器线程处理
+    struct SweepPlan {
+        std::int64_t          cutoff{0}; // 早于该时间的记录过期, retentionDays 为 0 时不使用
+        std::size_t           cap{0};    // 记录总数上限, 0 表示不限制
+        std::vector<PlayerId> expired;   // 有过期记录的玩家
+        std::vector<PlayerId> overflow;  // 超出总数上限时按最近死亡时间从早到晚删除的玩家
+    };
+
+    mutable PlayerRecordCache<DeathInfos>   mDeathInfoMap;          // 写时复制; 按需加载时 const 访问也会填充
+    std::unordered_map<PlayerId, Retention> mRetention;             // 所有有死亡记录的玩家
+    TimeIndex                               mByOldest;              // 按最早记录时间排序, 用于清理过期记录
+    TimeIndex                               mByNewest;              // 按最近死亡时间排序, 超出总数上限时从头删除
+    std::size_t                             mTotalDeathInfos{0};    // 所有玩家的记录总数
+    bool                                    mRetentionDirty{false}; // 概要自上次回写后有变化
+    mutable std::mutex                      mRetentionMutex;        // 回写在线程池中编码概要, 与服务器线程上的修改互斥
+    std::uint64_t                           mLoadGeneration{0};     // 每次卸载递增, 丢弃此前发起的后台任务
+    bool                                    mSweepPending{false};   // 清理所需的记录正在线程池中读取
+
+    DeathInfos const* findDeathInfos(RealName const& realName) const; // 按需加载模式下未缓存时同步读取
+
+    std::optional<DeathInfos> readDeathInfos(RealName const& realName) const; // 从数据库读取单个玩家的死亡记录
+
+    void migrateLegacyDeathInfos(); // 将旧版单键数据流式拆分为按玩家存储的二进制数据
+
+    static std::size_t getCapacity(); // 当前配置的每位玩家死亡记录上限
+
+    void updateRetention(PlayerId id, DeathInfos const* infos); // 记录变化后更新概要, infos 为空表示已删除
+
+    void setRetention(PlayerId id, std::optional<Retention> retention);
+
+    static Retention makeRetention(DeathInfos const& infos); // infos 不能为空
+
+    std::string encodeRetention() const; // 按最近死亡时间顺序编码概要, 调用方须持有 mRetentionMutex
+
+    bool loadRetention(); // 读取概要键, 不存在、损坏或本次启动重放过日志时返回 false
+
+    void rebuildRetentionAsync(); // 在线程池中扫描全部记录重建概要, 完成后在服务器线程合并
+
+    void removeDeathInfos(PlayerId id, RealName const& realName);
+
+    void expireDeathInfos(PlayerId id, std::int64_t cutoff); // 删除该玩家早于 cutoff 的记录
+
+    SweepPlan planSweep() const; // 按概要选出本轮清理的玩家, 最多 SWEEP_BATCH 个
+
+    void applySweep(SweepPlan const& plan); // 只处理已缓存的玩家, 未缓存的留待下一轮
 
 public:
     TPS_DISALLOW_COPY(DeathStorage);
 
     TPSAPI explicit DeathStorage();
 
+    inline static std::string name = "DeathStorage";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
+    TPSNDAPI std::vector<std::string> getDependencies() const override;
+
     TPSAPI void load() override;
     TPSAPI void unload() override;
-    TPSAPI void writeBack() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
+
+    TPSAPI void onPlayerJoin(RealName const& realName) override;
+    TPSAPI void onPlayerDisconnect(RealName const& realName) override;
+    TPSAPI void evictIdle() override;
+    TPSAPI void onConfigReload() override; // maxDeathInfos 变化时调整已缓存记录的容量
+    TPSAPI void sweep() override;          // 按 retentionDays 与 maxTotalDeathInfos 增量清理
+
+    TPSNDAPI std::size_t getTotalDeathInfos() const;
 
     TPSNDAPI bool hasDeathInfo(RealName const& realName) const;
 
@@ -47,7 +128,27 @@ class DeathStorage final : public IStorage {
 
     TPSAPI bool clearDeathInfo(RealName const& realName);
 
-    static inline constexpr auto STORAGE_KEY = "death";
+    TPSNDAPI static std::string makePlayerKey(RealName const& realName);
+
+    TPSNDAPI static std::string encodeDeathInfos(DeathInfos const& infos); // 编码为二进制格式
+
+    // 解码二进制格式, 兼容旧版 JSON; 超出 capacity 的旧记录被丢弃
+    TPSNDAPI static DeathInfos decodeDeathInfos(std::string_view data, std::size_t capacity);
+
+    // 流式读取旧版单键数据 {realName: [deathInfo...]}, 每读完一个玩家调用一次 fn
+    TPSAPI static void readLegacyDeathInfos(
+        std::string_view                                                          data,
+        std::function<void(std::string_view realName, DeathRecords infos)> const& fn
+    );
+
+    static inline constexpr auto STORAGE_KEY = "death";         // 旧版单键数据
+    static inline constexpr auto KEY_PREFIX  = "death/";        // death/<realName>
+    static inline constexpr auto SUMMARY_KEY = "death#summary"; // 保留策略概要, 不以 KEY_PREFIX 开头
+
+    static inline constexpr std::uint8_t BINARY_VERSION  = 2; // v2: 时间改为 i64 时间戳
+    static inline constexpr std::uint8_t SUMMARY_VERSION = 1;
+
+    static inline constexpr std::size_t SWEEP_BATCH = 256; // 每次清理最多处理的玩家数
 };
 
 } // namespace ltps::death
@@ -29,7 +29,7 @@ void DeathGUI::sendMainMenu(Player& player, BackCB backCb) {
 
     int index = 0;
     for (auto& info : *infos) {
-        fm.appendButton("{}\n{}"_tr(info.time, info.toPosString()), [index](Player& self) {
+        fm.appendButton("{}\n{}"_tr(info.getTimeString(), info.toPosString()), [index](Player& self) {
             sendBackGUI(self, index, BackSimpleForm::makeCallback<sendMainMenu>(nullptr));
         });
         index++;
@@ -53,7 +53,7 @@ void DeathGUI::sendBackGUI(Player& player, int index, BackCB backCb) {
 
     BackSimpleForm{std::move(backCb)}
         .setTitle("Death - 死亡信息"_trl(localeCode))
-        .setContent("死亡时间: {0}\n死亡坐标: {1}"_trl(localeCode, info->time, info->toPosString()))
+        .setContent("死亡时间: {0}\n死亡坐标: {1}"_trl(localeCode, info->getTimeString(), info->toPosString()))
         .appendButton(
             "前往死亡点"_trl(localeCode),
             [index](Player& self) {
@@ -89,8 +89,8 @@ void HomeCommand::setup() {
                     home->y,
                     home->z,
                     VanillaDimensions::toString(home->dimid),
-                    home->createdTime,
-                    home->modifiedTime
+                    home->getCreatedTimeString(),
+                    home->getModifiedTimeString()
                 )
             );
         }
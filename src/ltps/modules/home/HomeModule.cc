@@ -214,14 +214,14 @@ bool HomeModule::enable() {
                 throw std::runtime_error("HomeStorage not found");
             }
 
-            auto home = storage->getHome(realName, name);
-            if (!home) {
+            auto handle = storage->findHome(realName, name);
+            if (!handle) {
                 mc_utils::sendText<mc_utils::Error>(player, "家园不存在"_trl(localeCode));
                 ev.cancel();
                 return;
             }
 
-            auto teleporting = HomeTeleportingEvent(player, home.value());
+            auto teleporting = HomeTeleportingEvent(player, *storage, *handle);
             bus.publish(teleporting);
 
             if (teleporting.isCancelled()) {
@@ -229,12 +229,25 @@ bool HomeModule::enable() {
                 return;
             }
 
+            // 监听器可能修改了该玩家的家, 句柄失效时按名称重新查找
+            auto home = storage->resolve(*handle);
+            if (!home) {
+                handle = storage->findHome(realName, name);
+                home   = handle ? storage->resolve(*handle) : nullptr;
+            }
+            if (!home) {
+                mc_utils::sendText<mc_utils::Error>(player, "家园不存在"_trl(localeCode));
+                ev.cancel();
+                return;
+            }
             home->teleport(player);
 
-            auto teleported = HomeTeleportedEvent(player, home.value());
+            // 监听器可能删除或改名该记录, 回调使用事件发布前的副本
+            auto target     = *home;
+            auto teleported = HomeTeleportedEvent(player, *storage, *handle);
 
             bus.publish(teleported);
-            ev.invokeCallback(home.value());
+            ev.invokeCallback(std::move(target));
         },
         ll::event::EventPriority::High
     ));
@@ -245,6 +258,12 @@ bool HomeModule::enable() {
             auto  realName   = player.getRealName();
             auto  localeCode = player.getLocaleCode();
 
+            auto home = ev.getHome();
+            if (!home) {
+                ev.cancel(); // 前面的监听器修改或删除了该家园
+                return;
+            }
+
             auto& cooldown = getCooldown();
 
             if (cooldown.isCooldown(realName)) {
@@ -257,7 +276,7 @@ bool HomeModule::enable() {
             }
 
             auto cl = PriceCalculate(getConfig().modules.home.goHomeCalculate);
-            cl.addVariable("dimid", ev.getHome().dimid);
+            cl.addVariable("dimid", home->dimid);
             auto price = cl.eval();
 
             if (!price) {
@@ -265,7 +284,7 @@ bool HomeModule::enable() {
                 TeleportSystem::getInstance().getSelf().getLogger().error(
                     "[HomeModule]: Calculate price failed! player: {}, homeName: {}, error: {}",
                     realName,
-                    ev.getHome().name,
+                    home->name,
                     price.error()
                 );
                 ev.cancel();
@@ -1,5 +1,9 @@
 #include "ltps/modules/home/HomeStorage.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/database/PlayerRegistry.h"
+#include "ltps/utils/BinaryUtils.h"
+#include "ltps/utils/JsonSaxReader.h"
 #include "ltps/utils/JsonUtls.h"
 #include "ltps/utils/McUtils.h"
 #include "ltps/utils/TimeUtils.h"
@@ -7,152 +11,474 @@
 #include "mc/world/actor/player/Player.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
 #include "nlohmann/json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
 #include <expected>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
 
 
 namespace ltps::home {
 
+namespace {
+
+using HomeSaxReader = json_utils::RecordSaxReader<HomeStorage::Home>;
+
+void assignHomeField(HomeStorage::Home& home, std::string_view field, HomeSaxReader::Value const& value) {
+    if (field == "x") {
+        json_utils::assignNumber(home.x, value);
+    } else if (field == "y") {
+        json_utils::assignNumber(home.y, value);
+    } else if (field == "z") {
+        json_utils::assignNumber(home.z, value);
+    } else if (field == "dimid") {
+        json_utils::assignNumber(home.dimid, value);
+    } else if (field == "name") {
+        json_utils::assignString(home.name, value);
+    } else if (field == "createdTime") {
+        json_utils::assignEpoch(home.createdTime, value);
+    } else if (field == "modifiedTime") {
+        json_utils::assignEpoch(home.modifiedTime, value);
+    }
+}
+
+} // namespace
+
 
 HomeStorage::HomeStorage() = default;
 
-void HomeStorage::load() {
-    auto& db = getDatabase();
+std::vector<std::string> HomeStorage::getDependencies() const { return {PlayerRegistry::name}; }
 
-    if (!db.has(STORAGE_KEY)) {
-        db.set(STORAGE_KEY, "{}");
+void HomeStorage::load() {
+    if (getDatabase().has(STORAGE_KEY)) {
+        migrateLegacyHomes();
     }
 
-    auto rawJson = db.get(STORAGE_KEY);
-    if (!rawJson.has_value()) {
-        throw std::runtime_error("Could not load home data");
+    mHomes.setLazy(getConfig().storage.lazyLoad);
+    if (mHomes.isLazy()) {
+        TeleportSystem::getInstance().getSelf().getLogger().info("Homes will be loaded on demand");
+        return;
     }
 
+    forEachWithPrefix(KEY_PREFIX, [this](std::string_view realName, std::string_view value) {
+        try {
+            mHomes.emplaceClean(getPlayerRegistry().intern(RealName{realName}), IndexedHomes{decodeHomes(value)});
+        } catch (const std::exception& e) {
+            throw std::runtime_error(
+                "Could not parse home data of player: " + std::string{realName} + ", " + e.what()
+            );
+        }
+    });
+
+    TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} homes", mHomes.size());
+}
+
+void HomeStorage::unload() {
+    mHomes.setLazy(false); // 丢弃尚未完成的异步加载
+    mHomes.clear();
+}
+
+void HomeStorage::writeBack(StorageBatch& batch) {
+    auto& registry = getPlayerRegistry();
+    auto  snapshot = mHomes.takeDirtySnapshot();
     try {
-        auto json = nlohmann::json::parse(rawJson.value());
-        if (!json.is_object()) {
-            throw std::runtime_error("Could not parse home data");
+        for (auto const& [id, homes] : snapshot) {
+            auto const& realName = registry.getName(id);
+            if (!homes || homes->empty()) {
+                batch.del(makePlayerKey(realName));
+                continue;
+            }
+            batch.set(makePlayerKey(realName), encodeHomes(homes->list()));
         }
+    } catch (...) {
+        mHomes.markDirty(snapshot);
+        throw;
+    }
+    batch.onComplete([this, snapshot = std::move(snapshot)](bool succeeded) {
+        succeeded ? mHomes.commitSnapshot() : mHomes.markDirty(snapshot);
+    });
+}
 
-        // for (auto& [key, value] : json.items()) {
-        //     Home home;
-        //     json_utils::json2structTryPatch(home, value);
-        //     mHomes[key].push_back(std::move(home));
-        // }
-        json_utils::json2struct(mHomes, json);
+void HomeStorage::onPlayerJoin(RealName const& realName) {
+    auto id = getPlayerRegistry().intern(realName);
+    mHomes.setOnline(id, true);
+    if (mHomes.contains(id)) {
+        return;
+    }
+    dispatchAsync([this, realName, id, epoch = mHomes.getEvictionEpoch()]() -> std::function<void()> {
+        auto homes = readHomes(realName);
+        if (!homes) {
+            return nullptr;
+        }
+        return [this, id, epoch, homes = std::move(*homes)]() mutable {
+            mHomes.emplaceLoaded(id, std::move(homes), epoch);
+        };
+    });
+}
 
-        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} homes", mHomes.size());
-    } catch (const nlohmann::json::parse_error& e) {
-        throw std::runtime_error("Could not parse home data");
+void HomeStorage::onPlayerDisconnect(RealName const& realName) {
+    if (auto id = getPlayerRegistry().find(realName)) {
+        mHomes.setOnline(*id, false);
     }
 }
 
-void HomeStorage::unload() { writeBack(); }
+void HomeStorage::evictIdle() {
+    auto& cfg = getConfig().storage;
+    mHomes.evictIdle(static_cast<std::size_t>(cfg.cacheCapacity), std::chrono::seconds{cfg.evictDelay});
+}
 
-void HomeStorage::writeBack() {
-    auto& db = getDatabase();
+std::optional<HomeStorage::IndexedHomes> HomeStorage::readHomes(RealName const& realName) const {
+    auto value = getDatabase().get(makePlayerKey(realName));
+    if (!value) {
+        return std::nullopt;
+    }
+    try {
+        return IndexedHomes{decodeHomes(*value)};
+    } catch (const std::exception& e) {
+        TeleportSystem::getInstance().getSelf().getLogger().error(
+            "Could not parse home data of player: {}, {}",
+            realName,
+            e.what()
+        );
+        return std::nullopt;
+    }
+}
 
-    auto json = json_utils::struct2json(mHomes);
-    db.set(STORAGE_KEY, json.dump());
+HomeStorage::IndexedHomes const* HomeStorage::findHomes(RealName const& realName) const {
+    auto id = findPlayerId(realName, makePlayerKey(realName), mHomes.isLazy());
+    if (!id) {
+        return nullptr;
+    }
+    mHomes.ensureLoaded(*id, [&] { return readHomes(realName); });
+    return mHomes.find(*id);
 }
 
-bool HomeStorage::hasPlayer(RealName const& realName) const { return mHomes.contains(realName); }
+void HomeStorage::publishHomes(RealName const& realName, IndexedHomes homes) {
+    auto id = getPlayerRegistry().intern(realName);
+    mHomes.set(id, std::move(homes));
+    markDirty();
 
-bool HomeStorage::hasHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
-        return false;
+    auto const& current = *mHomes.find(id);
+    if (current.empty()) {
+        journalDel(makePlayerKey(realName));
+    } else {
+        journalSet(makePlayerKey(realName), encodeHomes(current.list()));
     }
-    return std::any_of(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& home) {
-        return home.name == name;
-    });
 }
 
-std::optional<HomeStorage::Home> HomeStorage::getHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
-        return std::nullopt;
+std::string HomeStorage::makePlayerKey(RealName const& realName) { return KEY_PREFIX + realName; }
+
+// v1: [header][count: varint] { [x, y, z: f32][dimid: i32][name][createdTime][modifiedTime] } * count
+// v2: 同 v1, 但 createdTime / modifiedTime 为 i64 Unix 时间戳
+std::string HomeStorage::encodeHomes(Homes const& homes) {
+    binary_utils::Writer writer{8 + homes.size() * 48};
+    writer.writeHeader(BINARY_VERSION).writeVarUInt(homes.size());
+    for (auto const& home : homes) {
+        writer.writeF32(home.x).writeF32(home.y).writeF32(home.z).writeI32(home.dimid);
+        writer.writeString(home.name).writeI64(home.createdTime).writeI64(home.modifiedTime);
     }
-    auto it = std::find_if(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& home) {
-        return home.name == name;
-    });
-    if (it == mHomes[realName].end()) {
-        return std::nullopt;
+    return writer.release();
+}
+
+void HomeStorage::migrateLegacyHomes() {
+    auto& db     = getDatabase();
+    auto  legacy = db.get(STORAGE_KEY);
+    if (!legacy) {
+        return;
+    }
+
+    // 先写入新键，全部成功后再删除旧键，中途失败时下次启动会重新迁移
+    std::size_t count = 0;
+    try {
+        readLegacyHomes(*legacy, [&](std::string_view realName, Homes homes) {
+            if (homes.empty()) {
+                return;
+            }
+            if (!db.set(makePlayerKey(RealName{realName}), encodeHomes(homes))) {
+                throw std::runtime_error("Could not write home data of player: " + std::string{realName});
+            }
+            ++count;
+        });
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string{"Could not migrate legacy home data, "} + e.what());
     }
-    return *it;
+    db.del(STORAGE_KEY);
+
+    TeleportSystem::getInstance().getSelf().getLogger().info("Migrated legacy home data of {} players", count);
 }
 
-Result<void> HomeStorage::updateHome(RealName const& realName, std::string const& name, Home home) {
-    if (!mHomes.contains(realName)) {
-        return std::unexpected{"Home not found"};
+void HomeStorage::readLegacyHomes(
+    std::string_view                                                   data,
+    std::function<void(std::string_view realName, Homes homes)> const& fn
+) {
+    HomeSaxReader{HomeSaxReader::Layout::ObjectOfArrays, assignHomeField, fn}.parse(data);
+}
+
+HomeStorage::Homes HomeStorage::decodeHomes(std::string_view data) {
+    Homes homes;
+    if (!binary_utils::isBinary(data)) {
+        // 旧版 JSON 数据, 流式解析不构建 DOM
+        HomeSaxReader reader{HomeSaxReader::Layout::Array, assignHomeField, [&](std::string_view, Homes records) {
+            homes = std::move(records);
+        }};
+        reader.parse(data);
+        return homes;
+    }
+
+    binary_utils::Reader reader{data};
+    auto                 version = reader.readHeader();
+    if (version != 1 && version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported home data version: " + std::to_string(version));
+    }
+    auto readTime = [&]() -> std::int64_t {
+        return version == 1 ? time_utils::parseEpoch(reader.readString()) : reader.readI64();
     };
 
-    auto& homes = mHomes[realName];
+    auto count = reader.readVarUInt();
+    homes.reserve(std::min<std::size_t>(count, data.size() / 19)); // 单条记录至少 19 字节
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Home home{};
+        home.x            = reader.readF32();
+        home.y            = reader.readF32();
+        home.z            = reader.readF32();
+        home.dimid        = reader.readI32();
+        home.name         = reader.readString();
+        home.createdTime  = readTime();
+        home.modifiedTime = readTime();
+        homes.push_back(std::move(home));
+    }
+    return homes;
+}
 
-    auto it = std::find_if(homes.begin(), homes.end(), [&](Home const& h) { return h.name == name; });
-    if (it == homes.end()) {
+bool HomeStorage::hasPlayer(RealName const& realName) const { return findHomes(realName) != nullptr; }
+
+bool HomeStorage::hasHome(RealName const& realName, std::string const& name) const {
+    auto homes = findHomes(realName);
+    return homes && homes->find(name) != nullptr;
+}
+
+std::optional<HomeStorage::Home> HomeStorage::getHome(RealName const& realName, std::string const& name) const {
+    auto homes = findHomes(realName);
+    if (!homes) {
+        return std::nullopt;
+    }
+    if (auto home = homes->find(name)) {
+        return *home;
+    }
+    return std::nullopt;
+}
+
+std::optional<HomeStorage::HomeHandle>
+HomeStorage::findHome(RealName const& realName, std::string const& name) const {
+    auto homes = findHomes(realName);
+    if (!homes) {
+        return std::nullopt;
+    }
+    auto index = homes->indexOf(name);
+    if (!index) {
+        return std::nullopt;
+    }
+    auto id = getPlayerRegistry().find(realName); // findHomes 成功时一定已注册
+    return HomeHandle{*id, static_cast<std::uint32_t>(*index), homes->generation()};
+}
+
+HomeStorage::Home const* HomeStorage::resolve(HomeHandle handle) const {
+    auto homes = mHomes.find(handle.player);
+    if (!homes || homes->generation() != handle.generation || handle.index >= homes->size()) {
+        return nullptr;
+    }
+    return &homes->list()[handle.index];
+}
+
+Result<void> HomeStorage::updateHome(RealName const& realName, std::string const& name, Home home) {
+    auto current = findHomes(realName);
+    if (!current || !current->find(name)) {
         return std::unexpected{"Home not found"};
     }
+    if (home.name != name && current->find(home.name)) {
+        return std::unexpected{"Home name repeated"};
+    }
 
+    auto homes = *current; // 写时复制
     home.updateModifiedTime();
-    *it = std::move(home);
+    homes.replace(name, std::move(home));
+    publishHomes(realName, std::move(homes));
     return {};
 }
 
 Result<void> HomeStorage::addHome(RealName const& realName, Home home) {
-    if (!mHomes.contains(realName)) {
-        mHomes[realName] = {};
-    }
-    if (hasHome(realName, home.name)) {
+    auto current = findHomes(realName);
+    if (current && current->find(home.name)) {
         return std::unexpected("Home name repeated");
     }
-    mHomes[realName].push_back(std::move(home));
+    auto homes = current ? *current : IndexedHomes{}; // 写时复制
+    homes.add(std::move(home));
+    publishHomes(realName, std::move(homes));
     return {};
 }
 
 Result<void> HomeStorage::removeHome(RealName const& realName, std::string const& name) {
-    if (!mHomes.contains(realName)) {
+    auto current = findHomes(realName);
+    if (!current || !current->find(name)) {
         return std::unexpected{"Home not found"};
     }
-    auto it =
-        std::remove_if(mHomes[realName].begin(), mHomes[realName].end(), [&](Home const& h) { return h.name == name; });
-    if (it == mHomes[realName].end()) {
-        return std::unexpected{"Home not found"};
-    }
-    mHomes[realName].erase(it, mHomes[realName].end());
+    auto homes = *current; // 写时复制
+    homes.remove(name);
+    publishHomes(realName, std::move(homes));
     return {};
 }
 
 Result<int> HomeStorage::getHomeCount(RealName const& realName) const {
-    if (!mHomes.contains(realName)) {
+    auto homes = findHomes(realName);
+    if (!homes) {
         return std::unexpected("Player not found");
     }
-    return mHomes.at(realName).size();
+    return static_cast<int>(homes->size());
+}
+
+HomeStorage::Homes const& HomeStorage::getHomes(RealName const& realName) const {
+    static Homes const empty{};
+    auto               homes = findHomes(realName);
+    return homes ? homes->list() : empty;
+}
+
+std::vector<HomeStorage::HomeHit> HomeStorage::getNearestHomes(
+    RealName const& realName,
+    int             dimid,
+    Vec3 const&     pos,
+    std::size_t     limit,
+    float           maxDistance
+) const {
+    std::vector<HomeHit> hits;
+    auto                 homes = findHomes(realName);
+    if (!homes) {
+        return hits;
+    }
+    for (auto const& [index, distance] : homes->coords().nearest(dimid, pos.x, pos.y, pos.z, limit, maxDistance)) {
+        hits.push_back({homes->list()[index].name, distance});
+    }
+    return hits;
+}
+
+HomeStorage::HomeMap const& HomeStorage::getAllHomes() const { return mHomes.records(); }
+
+std::vector<RealName> HomeStorage::getPlayers() const {
+    auto&                 registry = getPlayerRegistry();
+    std::vector<RealName> players;
+    for (auto const& [id, homes] : mHomes.records()) {
+        if (!homes->empty()) {
+            players.push_back(registry.getName(id));
+        }
+    }
+    if (!mHomes.isLazy()) {
+        return players;
+    }
+
+    // 补充数据库中未缓存的玩家
+    forEachWithPrefix(KEY_PREFIX, [&](std::string_view realName, std::string_view) {
+        RealName name{realName};
+        auto     id = registry.find(name);
+        if (!id || (!mHomes.contains(*id) && !mHomes.isPending(*id))) {
+            players.push_back(std::move(name));
+        }
+    });
+    return players;
+}
+
+
+std::uint64_t HomeStorage::IndexedHomes::nextGeneration() {
+    static std::atomic<std::uint64_t> counter{0}; // 记录可能在线程池中并行构造
+    return ++counter;
 }
 
-HomeStorage::Homes const& HomeStorage::getHomes(RealName const& realName) {
-    if (!mHomes.contains(realName)) {
-        mHomes[realName] = {};
+HomeStorage::IndexedHomes::IndexedHomes(Homes homes) {
+    mList.reserve(homes.size());
+    mIndex.reserve(homes.size());
+    mCoords.reserve(homes.size());
+    for (auto& home : homes) {
+        add(std::move(home));
     }
-    return mHomes[realName];
 }
 
-HomeStorage::HomeMap const& HomeStorage::getAllHomes() const { return mHomes; }
+HomeStorage::Home const* HomeStorage::IndexedHomes::find(std::string const& name) const {
+    auto iter = mIndex.find(name);
+    return iter == mIndex.end() ? nullptr : &mList[iter->second];
+}
+
+std::optional<std::size_t> HomeStorage::IndexedHomes::indexOf(std::string const& name) const {
+    auto iter = mIndex.find(name);
+    if (iter == mIndex.end()) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
+bool HomeStorage::IndexedHomes::add(Home home) {
+    if (!mIndex.try_emplace(home.name, mList.size()).second) {
+        return false;
+    }
+    mCoords.push_back(home.dimid, home.x, home.y, home.z);
+    mList.push_back(std::move(home));
+    mGeneration = nextGeneration();
+    return true;
+}
+
+bool HomeStorage::IndexedHomes::replace(std::string const& name, Home home) {
+    auto iter = mIndex.find(name);
+    if (iter == mIndex.end()) {
+        return false;
+    }
+    auto pos = iter->second;
+    if (home.name != name) {
+        if (!mIndex.try_emplace(home.name, pos).second) {
+            return false;
+        }
+        mIndex.erase(name);
+    }
+    mCoords.set(pos, home.dimid, home.x, home.y, home.z);
+    mList[pos]  = std::move(home);
+    mGeneration = nextGeneration();
+    return true;
+}
+
+bool HomeStorage::IndexedHomes::remove(std::string const& name) {
+    auto iter = mIndex.find(name);
+    if (iter == mIndex.end()) {
+        return false;
+    }
+    auto pos = iter->second;
+    mIndex.erase(iter);
+    mList.erase(mList.begin() + static_cast<std::ptrdiff_t>(pos));
+    mCoords.erase(pos);
+    for (auto i = pos; i < mList.size(); ++i) {
+        mIndex[mList[i].name] = i; // 保持创建顺序, 后续元素前移
+    }
+    mGeneration = nextGeneration();
+    return true;
+}
 
 
 HomeStorage::Home HomeStorage::Home::make(Vec3 const& vec3, int dimid, std::string const& name) {
-    auto time = time_utils::getCurrentTimeString();
+    auto time = time_utils::getCurrentEpoch();
     return Home{
         .x            = vec3.x,
         .y            = vec3.y,
         .z            = vec3.z,
         .dimid        = dimid,
         .createdTime  = time,
-        .modifiedTime = std::move(time),
+        .modifiedTime = time,
         .name         = name
     };
 }
 
 void HomeStorage::Home::teleport(Player& player) const { player.teleport(Vec3{x, y, z}, dimid, player.getRotation()); }
 
-void HomeStorage::Home::updateModifiedTime() { modifiedTime = time_utils::getCurrentTimeString(); }
+void HomeStorage::Home::updateModifiedTime() { modifiedTime = time_utils::getCurrentEpoch(); }
 
 void HomeStorage::Home::updatePosition(Vec3 const& vec3) {
     x = vec3.x;
@@ -164,5 +490,7 @@ std::string HomeStorage::Home::toString() const { return "{} => {}"_tr(name, toP
 std::string HomeStorage::Home::toPosString() const {
     return "{}({},{},{})"_tr(VanillaDimensions::toString(dimid), x, y, z);
 }
+std::string HomeStorage::Home::getCreatedTimeString() const { return time_utils::epochToString(createdTime); }
+std::string HomeStorage::Home::getModifiedTimeString() const { return time_utils::epochToString(modifiedTime); }
 
 } // namespace ltps::home
\ No newline at end of file
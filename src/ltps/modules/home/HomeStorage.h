@@ -1,7 +1,16 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/CoordinateColumns.h"
+#include "ltps/common/SpatialGrid.h"
+#include "ltps/database/PlayerRecordCache.h"
 #include "ltps/database/IStorage.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -14,11 +23,11 @@ namespace ltps::home {
 class HomeStorage final : public IStorage {
 public:
     struct Home {
-        float       x, y, z;      // 位置
-        int         dimid;        // 维度
-        std::string createdTime;  // 创建时间
-        std::string modifiedTime; // 修改时间
-        std::string name;         // 名称
+        float        x, y, z;      // 位置
+        int          dimid;        // 维度
+        std::int64_t createdTime;  // 创建时间 (Unix 时间戳, 秒)
+        std::int64_t modifiedTime; // 修改时间 (Unix 时间戳, 秒)
+        std::string  name;         // 名称
 
         TPSNDAPI static Home make(Vec3 const& vec3, int dimid, std::string const& name);
 
@@ -30,25 +39,91 @@ class HomeStorage final : public IStorage {
 
         TPSNDAPI std::string toString() const;
         TPSNDAPI std::string toPosString() const;
+        TPSNDAPI std::string getCreatedTimeString() const;  // 格式化为本地时间, 仅用于显示
+        TPSNDAPI std::string getModifiedTimeString() const; // 格式化为本地时间, 仅用于显示
     };
     using Homes   = std::vector<Home>;
-    using HomeMap = std::unordered_map<RealName, Homes>;
+    using HomeHit = SpatialGrid<std::string>::Hit; // 家园名称与距离
+
+    /**
+     * @brief 单个玩家的家: 保持创建顺序的列表 + 名称索引
+     * 按名称查找为 O(1)，删除时需要移动后续元素并更新其索引。
+     * 从旧数据构造时重名的家只保留第一个。
+     * 每次构造或修改都会分配全局唯一的代数 (generation)，用于校验 HomeHandle 是否过期。
+     */
+    class IndexedHomes {
+        Homes                                        mList;
+        std::unordered_map<std::string, std::size_t> mIndex;  // 名称 -> mList 下标
+        CoordinateColumns                            mCoords; // mList 坐标的列存副本, 下标与 mList 一致
+        std::uint64_t                                mGeneration{nextGeneration()};
+
+        static std::uint64_t nextGeneration();
+
+    public:
+        IndexedHomes() = default;
+        TPSAPI explicit IndexedHomes(Homes homes);
+
+        [[nodiscard]] Homes const&             list() const { return mList; }
+        [[nodiscard]] CoordinateColumns const& coords() const { return mCoords; }
+        [[nodiscard]] std::size_t  size() const { return mList.size(); }
+        [[nodiscard]] bool         empty() const { return mList.empty(); }
+
+        [[nodiscard]] std::uint64_t generation() const { return mGeneration; }
+
+        TPSNDAPI Home const* find(std::string const& name) const;
+
+        TPSNDAPI std::optional<std::size_t> indexOf(std::string const& name) const;
+
+        TPSAPI bool add(Home home);                               // 名称已存在时返回 false
+        TPSAPI bool replace(std::string const& name, Home home); // 名称不存在或改名后重名时返回 false
+        TPSAPI bool remove(std::string const& name);
+    };
+    using HomeMap = PlayerRecordCache<IndexedHomes>::Map;
+
+    // 家园句柄: 该玩家的家被修改 (增删改任意一个) 或从缓存中淘汰后失效
+    struct HomeHandle {
+        PlayerId      player;
+        std::uint32_t index;
+        std::uint64_t generation;
+    };
 
 private:
-    HomeMap mHomes; // 玩家名 -> 家
+    mutable PlayerRecordCache<IndexedHomes> mHomes; // 玩家 ID -> 家 (写时复制; 按需加载时 const 访问也会填充)
+
+    void publishHomes(RealName const& realName, IndexedHomes homes);
+
+    IndexedHomes const* findHomes(RealName const& realName) const; // 按需加载模式下未缓存时同步读取
+
+    std::optional<IndexedHomes> readHomes(RealName const& realName) const; // 从数据库读取单个玩家的家
+
+    void migrateLegacyHomes(); // 将旧版单键数据流式拆分为按玩家存储的二进制数据
 
 public:
     TPSAPI explicit HomeStorage();
 
+    inline static std::string name = "HomeStorage";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
+    TPSNDAPI std::vector<std::string> getDependencies() const override;
+
     TPSAPI void load() override;
     TPSAPI void unload() override;
-    TPSAPI void writeBack() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
+
+    TPSAPI void onPlayerJoin(RealName const& realName) override;
+    TPSAPI void onPlayerDisconnect(RealName const& realName) override;
+    TPSAPI void evictIdle() override;
 
     TPSNDAPI bool hasPlayer(RealName const& realName) const;
 
-    TPSNDAPI bool hasHome(RealName const& realName, std::string const& name);
+    TPSNDAPI bool hasHome(RealName const& realName, std::string const& name) const;
+
+    TPSNDAPI std::optional<Home> getHome(RealName const& realName, std::string const& name) const; // 拷贝
+
+    TPSNDAPI std::optional<HomeHandle> findHome(RealName const& realName, std::string const& name) const;
 
-    TPSNDAPI std::optional<Home> getHome(RealName const& realName, std::string const& name);
+    // 句柄失效时返回 nullptr; 返回的引用在该玩家的家下一次被修改之前有效 (同一 tick 内), 不应跨 tick 保存
+    TPSNDAPI Home const* resolve(HomeHandle handle) const;
 
     TPSNDAPI Result<void> updateHome(RealName const& realName, std::string const& name, Home home);
 
@@ -58,11 +133,35 @@ class HomeStorage final : public IStorage {
 
     TPSNDAPI Result<int> getHomeCount(RealName const& realName) const;
 
-    TPSNDAPI Homes const& getHomes(RealName const& realName);
+    TPSNDAPI Homes const& getHomes(RealName const& realName) const;
+
+    // 玩家在同一维度内距离最近的至多 limit 个家, 按距离升序
+    // 单个玩家的家数量受 maxHome 限制且按需加载, 因此直接扫描该玩家的坐标列而不维护全局网格
+    TPSNDAPI std::vector<HomeHit> getNearestHomes(
+        RealName const& realName,
+        int             dimid,
+        Vec3 const&     pos,
+        std::size_t     limit,
+        float           maxDistance = std::numeric_limits<float>::infinity()
+    ) const;
+
+    TPSNDAPI HomeMap const& getAllHomes() const; // 按需加载模式下仅包含已缓存的玩家
+
+    TPSNDAPI std::vector<RealName> getPlayers() const; // 所有拥有家园的玩家 (含未缓存的玩家)
+
+    TPSNDAPI static std::string makePlayerKey(RealName const& realName);
+
+    TPSNDAPI static std::string encodeHomes(Homes const& homes);    // 编码为二进制格式
+    TPSNDAPI static Homes       decodeHomes(std::string_view data); // 解码二进制格式, 兼容旧版 JSON
+
+    // 流式读取旧版单键数据 {realName: [home...]}, 每读完一个玩家调用一次 fn
+    TPSAPI static void
+    readLegacyHomes(std::string_view data, std::function<void(std::string_view realName, Homes homes)> const& fn);
 
-    TPSNDAPI HomeMap const& getAllHomes() const;
+    static inline constexpr auto STORAGE_KEY = "home";  // 旧版: 所有玩家的家存储在同一个键下
+    static inline constexpr auto KEY_PREFIX  = "home/"; // 新版: home/<realName>
 
-    static inline constexpr auto STORAGE_KEY = "home";
+    static inline constexpr std::uint8_t BINARY_VERSION = 2; // v2: 时间改为 i64 时间戳
 };
 
 
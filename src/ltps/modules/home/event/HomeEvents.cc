@@ -80,26 +80,42 @@ PlayerRequestGoHomeEvent::PlayerRequestGoHomeEvent(Player& player, std::string n
 : IPlayerRequestActionEvent(player, std::move(name)),
   mCallback(std::move(callback)) {}
 
-void PlayerRequestGoHomeEvent::invokeCallback(home::HomeStorage::Home home) const {
+void PlayerRequestGoHomeEvent::invokeCallback(home::HomeStorage::Home const& home) const {
     if (mCallback) {
-        mCallback(mPlayer, mName, std::move(home));
+        mCallback(mPlayer, mName, home);
     }
 }
 
 // ITeleportHomeEvent
-ITeleportHomeEvent::ITeleportHomeEvent(Player& player, home::HomeStorage::Home const& home)
+ITeleportHomeEvent::ITeleportHomeEvent(
+    Player&                       player,
+    home::HomeStorage const&      storage,
+    home::HomeStorage::HomeHandle handle
+)
 : mPlayer(player),
-  mHome(home) {}
+  mStorage(storage),
+  mHandle(handle) {}
+
+Player& ITeleportHomeEvent::getPlayer() const { return mPlayer; }
 
-Player&                        ITeleportHomeEvent::getPlayer() const { return mPlayer; }
-home::HomeStorage::Home const& ITeleportHomeEvent::getHome() const { return mHome; }
+home::HomeStorage::Home const* ITeleportHomeEvent::getHome() const { return mStorage.resolve(mHandle); }
+
+home::HomeStorage::HomeHandle ITeleportHomeEvent::getHandle() const { return mHandle; }
 
 // HomeTeleportingEvent & HomeTeleportedEvent
-HomeTeleportingEvent::HomeTeleportingEvent(Player& player, home::HomeStorage::Home const& home)
-: ITeleportHomeEvent(player, home) {}
+HomeTeleportingEvent::HomeTeleportingEvent(
+    Player&                       player,
+    home::HomeStorage const&      storage,
+    home::HomeStorage::HomeHandle handle
+)
+: ITeleportHomeEvent(player, storage, handle) {}
 
-HomeTeleportedEvent::HomeTeleportedEvent(Player& player, home::HomeStorage::Home const& home)
-: ITeleportHomeEvent(player, home) {}
+HomeTeleportedEvent::HomeTeleportedEvent(
+    Player&                       player,
+    home::HomeStorage const&      storage,
+    home::HomeStorage::HomeHandle handle
+)
+: ITeleportHomeEvent(player, storage, handle) {}
 
 IMPL_EVENT_EMITTER(PlayerRequestGoHomeEvent);
 IMPL_EVENT_EMITTER(HomeTeleportingEvent);
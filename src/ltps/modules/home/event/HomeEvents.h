@@ -107,35 +107,53 @@ class HomeRemovedEvent final : public Event, public IRemoveHomeEvent {
  * 流程: PlayerRequestGoHomeEvent -> HomeTeleportingEvent -> HomeStorage::Home::teleport -> HomeTeleportedEvent
  */
 class PlayerRequestGoHomeEvent final : public Cancellable<Event>, public IPlayerRequestActionEvent {
-    using Callback = std::function<void(Player& player, std::string name, home::HomeStorage::Home home)>;
+    using Callback = std::function<void(Player& player, std::string name, home::HomeStorage::Home const& home)>;
     Callback mCallback;
 
 public:
     TPSAPI explicit PlayerRequestGoHomeEvent(Player& player, std::string name, Callback callback = {});
 
-    TPSAPI void invokeCallback(home::HomeStorage::Home home) const;
+    TPSAPI void invokeCallback(home::HomeStorage::Home const& home) const;
 };
 
+/**
+ * 传送事件只携带家园句柄, getHome() 每次从 HomeStorage 解析, 不拷贝家园。
+ * 若监听器在事件期间修改了该玩家的家, getHome() 返回 nullptr。
+ */
 class ITeleportHomeEvent {
 protected:
-    Player&                        mPlayer;
-    home::HomeStorage::Home const& mHome;
+    Player&                       mPlayer;
+    home::HomeStorage const&      mStorage;
+    home::HomeStorage::HomeHandle mHandle;
 
 public:
-    TPSAPI explicit ITeleportHomeEvent(Player& player, home::HomeStorage::Home const& home);
+    TPSAPI explicit ITeleportHomeEvent(
+        Player&                       player,
+        home::HomeStorage const&      storage,
+        home::HomeStorage::HomeHandle handle
+    );
 
     TPSNDAPI Player& getPlayer() const;
-    TPSNDAPI home::HomeStorage::Home const& getHome() const;
+    TPSNDAPI home::HomeStorage::Home const* getHome() const; // 家园已被修改或删除时返回 nullptr
+    TPSNDAPI home::HomeStorage::HomeHandle  getHandle() const;
 };
 
 class HomeTeleportingEvent final : public Cancellable<Event>, public ITeleportHomeEvent {
 public:
-    TPSAPI explicit HomeTeleportingEvent(Player& player, home::HomeStorage::Home const& home);
+    TPSAPI explicit HomeTeleportingEvent(
+        Player&                       player,
+        home::HomeStorage const&      storage,
+        home::HomeStorage::HomeHandle handle
+    );
 };
 
 class HomeTeleportedEvent final : public Event, public ITeleportHomeEvent {
 public:
-    TPSAPI explicit HomeTeleportedEvent(Player& player, home::HomeStorage::Home const& home);
+    TPSAPI explicit HomeTeleportedEvent(
+        Player&                       player,
+        home::HomeStorage const&      storage,
+        home::HomeStorage::HomeHandle handle
+    );
 };
 
 
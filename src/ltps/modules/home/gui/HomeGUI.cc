@@ -6,11 +6,13 @@
 #include "ltps/TeleportSystem.h"
 #include "ltps/base/Config.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/FormPager.h"
 #include "ltps/modules/home/HomeStorage.h"
 #include "ltps/modules/home/event/HomeEvents.h"
 #include "ltps/utils/McUtils.h"
 
 #include <mc/world/level/dimension/VanillaDimensions.h>
+#include <cstddef>
 
 
 namespace ltps::home {
@@ -82,26 +84,52 @@ void HomeGUI::sendAddHomeGUI(Player& player) {
 }
 
 
-void HomeGUI::sendChooseHomeGUI(Player& player, ChooseHomeCallback chooseCB) {
+void HomeGUI::sendChooseHomeGUI(Player& player, ChooseHomeCallback chooseCB, std::size_t page) {
     auto localeCode = player.getLocaleCode();
+    auto realName   = player.getRealName();
+    auto dimid      = player.getDimensionId();
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
+
+    // 当前维度的家按距离由近到远排在前面 (带距离), 其余维度的家保持创建顺序 (距离记为负数)
+    auto entries = storage->getNearestHomes(realName, dimid, player.getPosition(), storage->getHomes(realName).size());
+    for (auto const& home : storage->getHomes(realName)) {
+        if (home.dimid != dimid) {
+            entries.push_back({home.name, -1.0f});
+        }
+    }
 
-    auto fm = BackSimpleForm::make<HomeGUI::sendMainMenu>(BackCB{});
-    fm.setTitle("Choose Home"_trl(localeCode)).setContent("请选择一个家"_trl(localeCode));
-
-    auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
+    FormPager pager{entries.size(), page};
 
-    auto homes = storage->getHomes(player.getRealName());
-    for (auto& home : homes) {
-        auto _name = home.name; // 拷贝名称，避免 move 后显示空字符串
-        fm.appendButton(_name, [chooseCB, home = std::move(home)](Player& self) { chooseCB(self, home); });
+    auto fm = BackSimpleForm::make<HomeGUI::sendMainMenu>(BackCB{});
+    fm.setTitle("Choose Home"_trl(localeCode))
+        .setContent("请选择一个家 ({})"_trl(localeCode, pager.describe(localeCode)));
+
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        auto const& entry = entries[i];
+        auto        label = entry.distance < 0 ? entry.key : "{}\n{:.1f}m"_trl(localeCode, entry.key, entry.distance);
+        // 只保存名称, 点击时再取家园, 期间被删除或修改也不会使用过期数据
+        fm.appendButton(std::move(label), [chooseCB, name = entry.key](Player& self) {
+            auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
+            auto home    = storage->getHome(self.getRealName(), name);
+            if (!home) {
+                mc_utils::sendText<mc_utils::Error>(self, "家园不存在"_trl(self.getLocaleCode()));
+                return;
+            }
+            chooseCB(self, std::move(*home));
+        });
     }
+    pager.appendButtons(fm, localeCode, [chooseCB](Player& self, std::size_t target) {
+        sendChooseHomeGUI(self, chooseCB, target);
+    });
 
     fm.sendTo(player);
 }
-void HomeGUI::sendChooseHomeGUI(Player& player, ChooseNameCallBack chooseCB) {
-    sendChooseHomeGUI(player, [cb = std::move(chooseCB)](Player& self, HomeStorage::Home home) {
-        cb(self, home.name);
-    });
+void HomeGUI::sendChooseHomeGUI(Player& player, ChooseNameCallBack chooseCB, std::size_t page) {
+    sendChooseHomeGUI(
+        player,
+        ChooseHomeCallback{[cb = std::move(chooseCB)](Player& self, HomeStorage::Home home) { cb(self, home.name); }},
+        page
+    );
 }
 
 void HomeGUI::sendGoHomeGUI(Player& player) {
@@ -132,8 +160,8 @@ void HomeGUI::_sendEditHomeGUI(Player& player, HomeStorage::Home home) {
             home.y,
             home.z,
             VanillaDimensions::toString(home.dimid),
-            home.createdTime,
-            home.modifiedTime
+            home.getCreatedTimeString(),
+            home.getModifiedTimeString()
         ))
         .appendButton(
             "修改名称"_trl(localeCode),
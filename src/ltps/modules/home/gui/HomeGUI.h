@@ -2,6 +2,7 @@
 #include "ltps/Global.h"
 #include "ltps/common/BackSimpleForm.h"
 #include "ltps/modules/home/HomeStorage.h"
+#include <cstddef>
 #include <functional>
 
 
@@ -21,8 +22,8 @@ class HomeGUI {
 
     using ChooseNameCallBack = std::function<void(Player& player, std::string name)>;
     using ChooseHomeCallback = std::function<void(Player& player, HomeStorage::Home home)>;
-    TPSAPI static void sendChooseHomeGUI(Player& player, ChooseNameCallBack chooseCB);
-    TPSAPI static void sendChooseHomeGUI(Player& player, ChooseHomeCallback chooseCB);
+    TPSAPI static void sendChooseHomeGUI(Player& player, ChooseNameCallBack chooseCB, std::size_t page = 0);
+    TPSAPI static void sendChooseHomeGUI(Player& player, ChooseHomeCallback chooseCB, std::size_t page = 0);
 
     TPSAPI static void sendGoHomeGUI(Player& player);
 
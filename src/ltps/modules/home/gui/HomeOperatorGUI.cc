@@ -6,11 +6,13 @@
 #include "ltps/Global.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/FormPager.h"
 #include "ltps/modules/home/HomeStorage.h"
 #include "ltps/modules/home/event/HomeEvents.h"
 #include "ltps/modules/home/gui/HomeOperatorGUI.h"
 #include "ltps/utils/McUtils.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
+#include <cstddef>
 #include <utility>
 
 
@@ -25,26 +27,36 @@ void HomeOperatorGUI::sendMainGUI(Player& player) {
     });
 }
 
-void HomeOperatorGUI::sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback) {
+void HomeOperatorGUI::sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback, std::size_t page) {
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
     if (!storage) {
         return;
     }
 
     auto localeCode = player.getLocaleCode();
+    auto players    = storage->getPlayers();
+
+    FormPager pager{players.size(), page};
 
     SimpleForm fm{"Teleport System - Home Manager"_trl(localeCode)};
-    fm.setContent("请选择一个玩家: "_trl(localeCode));
+    fm.setContent("请选择一个玩家 ({}): "_trl(localeCode, pager.describe(localeCode)));
 
-    auto const& map = storage->getAllHomes();
-    for (auto const& pair : map) {
-        fm.appendButton(pair.first, [callback, target = pair.first](Player& self) { callback(self, target); });
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        fm.appendButton(players[i], [callback, target = players[i]](Player& self) { callback(self, target); });
     }
+    pager.appendButtons(fm, localeCode, [callback](Player& self, std::size_t target) {
+        sendChoosePlayerGUI(self, callback, target);
+    });
 
     fm.sendTo(player);
 }
 
-void HomeOperatorGUI::sendChooseHomeGUI(Player& player, RealName targetPlayer, ChooseHomeCallback callback) {
+void HomeOperatorGUI::sendChooseHomeGUI(
+    Player&            player,
+    RealName           targetPlayer,
+    ChooseHomeCallback callback,
+    std::size_t        page
+) {
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
     if (!storage) {
         return;
@@ -54,20 +66,36 @@ void HomeOperatorGUI::sendChooseHomeGUI(Player& player, RealName targetPlayer, C
 
     auto& homes = storage->getHomes(targetPlayer);
 
+    FormPager pager{homes.size(), page};
+
     auto fm = BackSimpleForm::make<sendMainGUI>();
     fm.setTitle("Teleport System - Home Manager"_trl(localeCode));
-    fm.setContent("{} 共有 {} 个传送点, 请选择一个: "_trl(localeCode, targetPlayer, homes.size()));
+    fm.setContent("{} 共有 {} 个传送点, 请选择一个 ({}): "_trl(
+        localeCode,
+        targetPlayer,
+        homes.size(),
+        pager.describe(localeCode)
+    ));
 
     fm.appendButton("创建"_trl(localeCode), "textures/ui/color_plus", "path", [targetPlayer](Player& self) {
         sendCreateOrEditHomeGUI(self, targetPlayer);
     });
 
-    for (auto const& home : homes) {
-        auto _home = home;
-        fm.appendButton(home.name, [callback, target = targetPlayer, home = std::move(_home)](Player& self) {
-            callback(self, target, home);
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        // 只保存名称, 点击时再取家园
+        fm.appendButton(homes[i].name, [callback, target = targetPlayer, name = homes[i].name](Player& self) {
+            auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<HomeStorage>();
+            auto home    = storage->getHome(target, name);
+            if (!home) {
+                mc_utils::sendText<mc_utils::Error>(self, "家园 {} 不存在"_trl(self.getLocaleCode(), name));
+                return;
+            }
+            callback(self, target, std::move(*home));
         });
     }
+    pager.appendButtons(fm, localeCode, [callback, targetPlayer](Player& self, std::size_t target) {
+        sendChooseHomeGUI(self, targetPlayer, callback, target);
+    });
 
     fm.sendTo(player);
 }
@@ -75,15 +103,15 @@ void HomeOperatorGUI::sendChooseHomeGUI(Player& player, RealName targetPlayer, C
 void HomeOperatorGUI::sendOperatorMenu(Player& player, RealName targetPlayer, HomeStorage::Home home) {
     auto localeCode = player.getLocaleCode();
 
-    BackSimpleForm::make<sendChooseHomeGUI>(targetPlayer, sendOperatorMenu)
+    BackSimpleForm::make<sendChooseHomeGUI>(targetPlayer, sendOperatorMenu, std::size_t{0})
         .setTitle("Teleport System - Home Manager"_trl(localeCode))
         .setContent("所属玩家: {}\n家园名称: {}\n家园坐标: {}\n创建时间: {}\n修改时间: {}"_trl(
             localeCode,
             targetPlayer,
             home.name,
             home.toPosString(),
-            home.createdTime,
-            home.modifiedTime
+            home.getCreatedTimeString(),
+            home.getModifiedTimeString()
         ))
         .appendButton(
             "前往"_trl(localeCode),
@@ -1,6 +1,7 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/modules/home/HomeStorage.h"
+#include <cstddef>
 #include <functional>
 #include <optional>
 
@@ -17,10 +18,15 @@ class HomeOperatorGUI {
     TPSAPI static void sendMainGUI(Player& player);
 
     using ChoosePlayerCallback = std::function<void(Player& self, RealName realName)>;
-    TPSAPI static void sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback);
+    TPSAPI static void sendChoosePlayerGUI(Player& player, ChoosePlayerCallback callback, std::size_t page = 0);
 
     using ChooseHomeCallback = std::function<void(Player& self, RealName targetPlayer, HomeStorage::Home home)>;
-    TPSAPI static void sendChooseHomeGUI(Player& player, RealName targetPlayer, ChooseHomeCallback callback);
+    TPSAPI static void sendChooseHomeGUI(
+        Player&            player,
+        RealName           targetPlayer,
+        ChooseHomeCallback callback,
+        std::size_t        page = 0
+    );
 
     TPSAPI static void sendOperatorMenu(Player& player, RealName targetPlayer, HomeStorage::Home home);
 
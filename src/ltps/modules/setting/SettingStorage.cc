@@ -1,73 +1,150 @@
 #include "SettingStorage.h"
 #include "ltps/TeleportSystem.h"
+#include "ltps/base/Config.h"
+#include "ltps/database/PlayerRegistry.h"
 #include "ltps/utils/JsonUtls.h"
 #include "nlohmann/json.hpp"
+#include <chrono>
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 
 namespace ltps::setting {
 
 SettingStorage::SettingStorage() = default;
 
+std::vector<std::string> SettingStorage::getDependencies() const { return {PlayerRegistry::name}; }
+
 void SettingStorage::load() {
-    auto& database = getDatabase();
-    if (!database.has(STORAGE_KEY)) {
-        database.set(STORAGE_KEY, "{}");
+    if (getDatabase().has(STORAGE_KEY)) {
+        migrateLegacyObject(STORAGE_KEY, KEY_PREFIX);
     }
 
-    auto rawJson = database.get(STORAGE_KEY);
-    if (!rawJson.has_value()) {
-        throw std::runtime_error("Failed to load player settings");
+    mSettingDatas.setLazy(getConfig().storage.lazyLoad);
+    if (mSettingDatas.isLazy()) {
+        TeleportSystem::getInstance().getSelf().getLogger().info("Player settings will be loaded on demand");
+        return;
     }
 
-    try {
-        auto json = nlohmann::json::parse(rawJson.value());
-        if (!json.is_object()) {
-            throw std::runtime_error("Player settings is not an object");
+    forEachWithPrefix(KEY_PREFIX, [this](std::string_view realName, std::string_view value) {
+        try {
+            mSettingDatas.emplaceClean(getPlayerRegistry().intern(RealName{realName}), decodeSettingData(value));
+        } catch (const nlohmann::json::parse_error& e) {
+            throw std::runtime_error("Failed to parse player settings: " + std::string(e.what()));
         }
+    });
+
+    TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} player settings", mSettingDatas.size());
+}
 
-        for (auto& [key, value] : json.items()) {
-            SettingData settingData{};
-            json_utils::json2structTryPatch(settingData, value);
-            mSettingDatas[key] = settingData;
+void SettingStorage::unload() {
+    TeleportSystem::getInstance().getSelf().getLogger().trace("Unloading player settings");
+    mSettingDatas.setLazy(false);
+    mSettingDatas.clear();
+}
+
+void SettingStorage::writeBack(StorageBatch& batch) {
+    auto& registry = getPlayerRegistry();
+    auto  snapshot = mSettingDatas.takeDirtySnapshot();
+    try {
+        for (auto const& [id, settingData] : snapshot) {
+            auto const& realName = registry.getName(id);
+            if (!settingData) {
+                batch.del(makePlayerKey(realName));
+                continue;
+            }
+            batch.set(makePlayerKey(realName), json_utils::struct2json(*settingData).dump());
         }
+    } catch (...) {
+        mSettingDatas.markDirty(snapshot);
+        throw;
+    }
+    batch.onComplete([this, snapshot = std::move(snapshot)](bool succeeded) {
+        succeeded ? mSettingDatas.commitSnapshot() : mSettingDatas.markDirty(snapshot);
+    });
+}
+
+// 设置在进服时由 SettingModule 调用 initPlayerSetting 同步加载, 这里只记录在线状态
+void SettingStorage::onPlayerJoin(RealName const& realName) {
+    mSettingDatas.setOnline(getPlayerRegistry().intern(realName), true);
+}
 
-        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} player settings", mSettingDatas.size());
-    } catch (const nlohmann::json::parse_error& e) {
-        throw std::runtime_error("Failed to parse player settings: " + std::string(e.what()));
+void SettingStorage::onPlayerDisconnect(RealName const& realName) {
+    if (auto id = getPlayerRegistry().find(realName)) {
+        mSettingDatas.setOnline(*id, false);
     }
 }
 
-void SettingStorage::unload() {
-    TeleportSystem::getInstance().getSelf().getLogger().trace("Unloading player settings");
-    writeBack();
+void SettingStorage::evictIdle() {
+    auto& cfg = getConfig().storage;
+    mSettingDatas.evictIdle(static_cast<std::size_t>(cfg.cacheCapacity), std::chrono::seconds{cfg.evictDelay});
+}
+
+SettingData SettingStorage::decodeSettingData(std::string_view data) {
+    auto json = nlohmann::json::parse(data);
+    if (!json.is_object()) {
+        throw std::runtime_error("Player settings is not an object");
+    }
+
+    SettingData settingData{};
+    json_utils::json2structTryPatch(settingData, json);
+    return settingData;
 }
 
-void SettingStorage::writeBack() {
-    auto& database = getDatabase();
-    auto  json     = json_utils::struct2json(mSettingDatas);
-    database.set(STORAGE_KEY, json.dump());
+SettingData const* SettingStorage::findSettingData(RealName const& realName) const {
+    auto id = findPlayerId(realName, makePlayerKey(realName), mSettingDatas.isLazy());
+    if (!id) {
+        return nullptr;
+    }
+    mSettingDatas.ensureLoaded(*id, [&]() -> std::optional<SettingData> {
+        auto value = getDatabase().get(makePlayerKey(realName));
+        if (!value) {
+            return std::nullopt;
+        }
+        try {
+            return decodeSettingData(*value);
+        } catch (const std::exception& e) {
+            TeleportSystem::getInstance().getSelf().getLogger().error(
+                "Failed to parse player settings of {}: {}",
+                realName,
+                e.what()
+            );
+            return std::nullopt;
+        }
+    });
+    return mSettingDatas.find(*id);
 }
 
+void SettingStorage::publishSettingData(RealName const& realName, SettingData settingData) {
+    auto id = getPlayerRegistry().intern(realName);
+    mSettingDatas.set(id, std::move(settingData));
+    markDirty();
+    journalSet(makePlayerKey(realName), json_utils::struct2json(*mSettingDatas.find(id)).dump());
+}
+
+std::string SettingStorage::makePlayerKey(RealName const& realName) { return KEY_PREFIX + realName; }
+
 Result<SettingData> SettingStorage::getSettingData(RealName const& realName) const {
-    if (auto it = mSettingDatas.find(realName); it != mSettingDatas.end()) {
-        return it->second;
+    if (auto settingData = findSettingData(realName)) {
+        return *settingData;
     }
     return std::unexpected{"Player setting not found"};
 }
 
 void SettingStorage::initPlayerSetting(RealName const& realName) {
-    if (mSettingDatas.find(realName) == mSettingDatas.end()) {
-        mSettingDatas[realName] = SettingData{};
+    if (!findSettingData(realName)) {
+        publishSettingData(realName, SettingData{});
     }
 }
 
 
 Result<void> SettingStorage::setSettingData(RealName const& realName, SettingData settingData) {
-    mSettingDatas[realName] = settingData;
+    publishSettingData(realName, std::move(settingData));
     return {};
 }
 
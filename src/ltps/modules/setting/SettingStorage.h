@@ -1,8 +1,11 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/database/PlayerRecordCache.h"
 #include "ltps/database/IStorage.h"
 #include <memory>
-#include <unordered_map>
+#include <string>
+#include <string_view>
+#include <vector>
 
 
 namespace ltps::setting {
@@ -20,12 +23,27 @@ class SettingStorage final : public IStorage {
 
     TPSAPI explicit SettingStorage();
 
+    inline static std::string name = "SettingStorage";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
+    TPSNDAPI std::vector<std::string> getDependencies() const override;
+
     TPSAPI void load() override;
     TPSAPI void unload() override;
-    TPSAPI void writeBack() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
+
+    TPSAPI void onPlayerJoin(RealName const& realName) override;
+    TPSAPI void onPlayerDisconnect(RealName const& realName) override;
+    TPSAPI void evictIdle() override;
 
 private:
-    std::unordered_map<RealName, SettingData> mSettingDatas; // realName -> SettingData
+    mutable PlayerRecordCache<SettingData> mSettingDatas; // PlayerId -> SettingData
+
+    void publishSettingData(RealName const& realName, SettingData settingData);
+
+    SettingData const* findSettingData(RealName const& realName) const; // 按需加载模式下未缓存时同步读取
+
+    static SettingData decodeSettingData(std::string_view data);
 
 public:
     TPSNDAPI Result<SettingData> getSettingData(RealName const& realName) const;
@@ -34,7 +52,10 @@ class SettingStorage final : public IStorage {
 
     TPSAPI void initPlayerSetting(RealName const& realName);
 
-    static inline constexpr auto STORAGE_KEY = "rule";
+    TPSNDAPI static std::string makePlayerKey(RealName const& realName);
+
+    static inline constexpr auto STORAGE_KEY = "rule";  // 旧版单键数据
+    static inline constexpr auto KEY_PREFIX  = "rule/"; // rule/<realName>
 };
 
 
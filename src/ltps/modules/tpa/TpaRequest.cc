@@ -16,6 +16,7 @@
 #include "mc/platform/UUID.h"
 #include "mc/world/actor/player/Player.h"
 #include <chrono>
+#include <cstddef>
 #include <memory>
 
 
@@ -42,6 +43,10 @@ struct TpaRequest::Impl {
       mCreationTime(time_utils::now()),
       mExpirationTime(std::chrono::steady_clock::now() + std::chrono::seconds(getConfig().modules.tpa.expirationTime)) {
     }
+
+    // Impl 同样从回收池分配, 保留 pimpl 的同时创建请求不经过堆
+    static void* operator new(std::size_t size) { return BlockPool::of<Impl>().allocate(size); }
+    static void  operator delete(void* ptr, std::size_t size) { BlockPool::of<Impl>().deallocate(ptr, size); }
 };
 
 
@@ -49,6 +54,13 @@ TpaRequest::TpaRequest(Player& sender, Player& receiver, Type type)
 : mImpl(std::make_unique<Impl>(sender, receiver, type)) {}
 TpaRequest::~TpaRequest() = default;
 
+std::shared_ptr<TpaRequest> TpaRequest::create(Player& sender, Player& receiver, Type type) {
+    return std::allocate_shared<TpaRequest>(PoolAllocator<TpaRequest>{}, sender, receiver, type);
+}
+
+BlockPool::Stats TpaRequest::getPoolStats() { return BlockPool::of<TpaRequest>().getStats(); }
+BlockPool::Stats TpaRequest::getImplPoolStats() { return BlockPool::of<Impl>().getStats(); }
+
 Player*          TpaRequest::getSender() const { return mImpl->mSender.tryUnwrap<Player>().as_ptr(); }
 Player*          TpaRequest::getReceiver() const { return mImpl->mReceiver.tryUnwrap<Player>().as_ptr(); }
 mce::UUID const& TpaRequest::getSenderUUID() const { return mImpl->mSenderUUID; }
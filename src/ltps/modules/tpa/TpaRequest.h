@@ -1,5 +1,6 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/BlockPool.h"
 #include "mc/platform/UUID.h"
 #include <chrono>
 #include <memory>
@@ -36,6 +37,15 @@ class TpaRequest final : public std::enable_shared_from_this<TpaRequest> {
 
     TPSAPI ~TpaRequest();
 
+    // 从回收池创建请求, 对象与引用计数控制块共用一个池化内存块, Impl 取自另一个回收池
+    TPSNDAPI static std::shared_ptr<TpaRequest> create(Player& sender, Player& receiver, Type type);
+
+    // 请求 (含引用计数控制块) 回收池的分配统计
+    TPSNDAPI static BlockPool::Stats getPoolStats();
+
+    // Impl 回收池的分配统计
+    TPSNDAPI static BlockPool::Stats getImplPoolStats();
+
     TPSNDAPI Player* getSender() const;
 
     TPSNDAPI Player* getReceiver() const;
@@ -1,5 +1,8 @@
 #include "ltps/modules/tpa/TpaRequestPool.h"
-#include "ltps/common/TimeScheduler.h"
+#include "ltps/TeleportSystem.h"
+#include "ltps/common/BatchQueue.h"
+#include "ltps/common/PairIndex.h"
+#include "ltps/common/TimerService.h"
 #include "ltps/modules/tpa/TpaRequest.h"
 #include "ltps/modules/tpa/event/TpaEvents.h"
 #include "ltps/utils/McUtils.h"
@@ -14,29 +17,39 @@
 #include "mc/platform/UUID.h"
 #include "mc/world/actor/player/Player.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 namespace ltps::tpa {
 
 
-struct Compare {
-    bool operator()(std::shared_ptr<TpaRequest> const& lhs, std::shared_ptr<TpaRequest> const& rhs) const {
-        return lhs->getExpireTime() > rhs->getExpireTime();
-    }
-};
-
 struct TpaRequestPool::Impl {
-    TimeScheduler<TpaRequest, Compare> mRequestScheduler;
-
-    using RequestQueryMap = std::unordered_map<mce::UUID, std::unordered_map<mce::UUID, std::shared_ptr<TpaRequest>>>;
-    RequestQueryMap mForwardMap; // Receiver -> [Sender] -> Request
-    RequestQueryMap mReverseMap; // Sender -> [Receiver] -> Request
+    struct Entry {
+        std::shared_ptr<TpaRequest> request;
+        TimerService::TimerId       timer{TimerService::InvalidTimer}; // 到期定时器, 已触发时为 InvalidTimer
+    };
+
+    // 到期定时器在定时器工作线程中入队, 同一 tick 内到期的请求由一个服务器线程任务统一发布
+    // 工作线程上的回调可能与析构并发, 因此只持有队列; owner 仅在服务器线程中读写, 析构时置空
+    struct ExpiredQueue {
+        BatchQueue<std::shared_ptr<TpaRequest>> pending;
+        Impl*                                   owner{nullptr};
+    };
+
+    TimerService&               mTimerService;
+    PairIndex<mce::UUID, Entry> mRequests; // (Sender, Receiver) -> Request, 可按 Sender 或 Receiver 遍历
+
+    std::shared_ptr<ExpiredQueue>            mExpired;
+    std::vector<std::shared_ptr<TpaRequest>> mExpiredBatch; // 服务器线程复用的批次缓冲区
+    ExpirationStats                          mExpirationStats{};
+    mutable std::mutex                       mStatsMutex;
 
     ll::event::ListenerPtr mPLayerDisconnectListener;
     ll::event::ListenerPtr mRequestAcceptedListener;
@@ -47,41 +60,43 @@ struct TpaRequestPool::Impl {
     mutable std::shared_mutex mMutex;
 
     void addRequestImpl(std::shared_ptr<TpaRequest> const& request) {
-        auto& sender   = request->getSenderUUID();
-        auto& receiver = request->getReceiverUUID();
-        {
-            std::unique_lock lock{mMutex};
-            mRequestScheduler.add(request);
-            mForwardMap[receiver][sender] = request;
-            mReverseMap[sender][receiver] = request;
+        std::unique_lock lock{mMutex};
+
+        auto [entry, inserted] = mRequests.try_emplace(request->getSenderUUID(), request->getReceiverUUID());
+        if (!inserted) {
+            mTimerService.cancel(entry->timer); // 覆盖旧请求, 旧请求不再到期
+        }
+        entry->request = request;
+        entry->timer   = mTimerService.scheduleAt(
+            request->getExpireTime(),
+            [expired = mExpired, request] { enqueueExpired(expired, request); },
+            TimerService::Dispatch::Worker
+        );
+    }
+
+    // 在定时器工作线程中执行, 每个批次只向服务器线程派发一个任务
+    static void enqueueExpired(std::shared_ptr<ExpiredQueue> const& expired, std::shared_ptr<TpaRequest> request) {
+        if (!expired->pending.push(std::move(request))) {
+            return; // 本批次已派发, 随同一任务发布
         }
+        ll::coro::keepThis([expired]() -> ll::coro::CoroTask<> {
+            if (expired->owner) {
+                expired->owner->publishExpired();
+            }
+            co_return;
+        }).launch(ll::thread::ServerThreadExecutor::getDefault());
     }
 
     bool hasRequestImpl(mce::UUID const& sender, mce::UUID const& receiver) {
         std::shared_lock lock{mMutex};
-        auto             iter = mForwardMap.find(receiver);
-        if (iter == mForwardMap.end()) {
-            return false;
-        }
-        if (!iter->second.contains(sender)) {
-            return false;
-        }
-        return true;
+        return mRequests.contains(sender, receiver);
     }
 
+    // 请求已处理 (接受 / 拒绝 / 取消 / 过期), 立即取消定时器并释放索引持有的引用
     void removeRequestImpl(mce::UUID const& sender, mce::UUID const& receiver) {
         std::unique_lock lock{mMutex};
-        if (auto iter = mForwardMap.find(receiver); iter != mForwardMap.end()) {
-            iter->second.erase(sender); // delete mForwardMap[receiver][sender]
-            if (iter->second.empty()) {
-                mForwardMap.erase(iter); // delete mForwardMap[receiver]
-            }
-        }
-        if (auto iter = mReverseMap.find(sender); iter != mReverseMap.end()) {
-            iter->second.erase(receiver); // delete mReverseMap[sender][receiver]
-            if (iter->second.empty()) {
-                mReverseMap.erase(iter); // delete mReverseMap[sender]
-            }
+        if (auto entry = mRequests.extract(sender, receiver)) {
+            mTimerService.cancel(entry->timer);
         }
     }
 
@@ -91,12 +106,8 @@ struct TpaRequestPool::Impl {
 
     std::shared_ptr<TpaRequest> getRequestImpl(mce::UUID const& sender, mce::UUID const& receiver) {
         std::shared_lock lock{mMutex};
-        if (auto iter = mForwardMap.find(receiver); iter != mForwardMap.end()) {
-            if (auto iter2 = iter->second.find(sender); iter2 != iter->second.end()) {
-                return iter2->second;
-            }
-        }
-        return nullptr;
+        auto             entry = mRequests.find(sender, receiver);
+        return entry ? entry->request : nullptr;
     }
 
 
@@ -104,23 +115,11 @@ struct TpaRequestPool::Impl {
     markRequestAndRemove(Player& player, std::function<void(std::shared_ptr<TpaRequest> const& req)> const& callback) {
         std::unique_lock lock{mMutex};
 
-        auto uuid = player.getUuid();
-
-        // 标记所有发送给该玩家的请求为离线 (Receiver)
-        if (auto iter = mForwardMap.find(uuid); iter != mForwardMap.end()) {
-            for (auto& [sender, request] : iter->second) {
-                callback(request);
-            }
-            mForwardMap.erase(iter);
-        }
-
-        // 标记所有该玩家发送的请求为离线 (Sender)
-        if (auto iter = mReverseMap.find(uuid); iter != mReverseMap.end()) {
-            for (auto& [receiver, request] : iter->second) {
-                callback(request);
-            }
-            mReverseMap.erase(iter);
-        }
+        // 该玩家发送的与发送给该玩家的请求, 只遍历该玩家的两条链表
+        mRequests.eraseById(player.getUuid(), [&](auto const&, Entry&& entry) {
+            callback(entry.request);
+            mTimerService.cancel(entry.timer);
+        });
     }
 
     void markRequestOffline(Player& player) {
@@ -139,23 +138,57 @@ struct TpaRequestPool::Impl {
         });
     }
 
-    explicit Impl() {
-        mRequestScheduler.setExpireCallback([](std::shared_ptr<TpaRequest> const& req) {
+    // 在服务器线程中执行, 发布当前批次中全部过期请求
+    void publishExpired() {
+        auto begin = std::chrono::steady_clock::now();
+
+        mExpired->pending.drain(mExpiredBatch);
+        {
+            std::unique_lock lock{mMutex};
+            for (auto const& req : mExpiredBatch) {
+                if (auto entry = mRequests.find(req->getSenderUUID(), req->getReceiverUUID());
+                    entry && entry->request == req) {
+                    entry->timer = TimerService::InvalidTimer;
+                }
+            }
+        }
+
+        std::size_t published = 0;
+        auto&       bus       = ll::event::EventBus::getInstance();
+        for (auto const& req : mExpiredBatch) {
             if (req->isFinalState() && req->getState() != TpaRequest::State::Expired) {
-                return; // 请求已经处理过，不再处理
+                continue; // 请求已经处理过，不再处理
             }
             req->tryUpdateState(TpaRequest::State::Expired);
-            ll::coro::keepThis([req]() -> ll::coro::CoroTask<> {
-                ll::event::EventBus::getInstance().publish(TpaRequestExpiredEvent{req});
-                co_return;
-            }).launch(ll::thread::ServerThreadExecutor::getDefault());
-        });
+            bus.publish(TpaRequestExpiredEvent{req});
+            ++published;
+        }
+        auto size = mExpiredBatch.size();
+        mExpiredBatch.clear(); // 保留容量, 释放请求引用
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+
+        std::lock_guard lock{mStatsMutex};
+        mExpirationStats.batches   += 1;
+        mExpirationStats.expired   += size;
+        mExpirationStats.published += published;
+        mExpirationStats.lastBatch  = size;
+        mExpirationStats.maxBatch   = std::max(mExpirationStats.maxBatch, size);
+        mExpirationStats.lastTime   = elapsed;
+        mExpirationStats.maxTime    = std::max(mExpirationStats.maxTime, elapsed);
+        mExpirationStats.totalTime += elapsed;
+    }
+
+    explicit Impl()
+    : mTimerService(TeleportSystem::getInstance().getTimerService()),
+      mExpired(std::make_shared<ExpiredQueue>()) {
+        mExpired->owner = this;
 
         auto& bus = ll::event::EventBus::getInstance();
         mPLayerDisconnectListener =
             bus.emplaceListener<ll::event::PlayerDisconnectEvent>([this](ll::event::PlayerDisconnectEvent& ev) {
                 auto& player = ev.self();
-                markRequestOffline(player); // 仅标记离线和删除查询表，调度器懒清理
+                markRequestOffline(player); // 标记离线, 删除查询表并取消定时器
             });
 
         mRequestAcceptedListener  = bus.emplaceListener<TpaRequestAcceptedEvent>([this](TpaRequestAcceptedEvent& ev) {
@@ -170,11 +203,12 @@ struct TpaRequestPool::Impl {
         mRequestExpiredListener   = bus.emplaceListener<TpaRequestExpiredEvent>([this](TpaRequestExpiredEvent& ev) {
             this->removeRequestImpl(ev.getRequest());
         });
-
-        mRequestScheduler.start();
     }
 
     ~Impl() {
+        // 发布任务与析构均在服务器线程, 置空后尚未执行的发布任务直接跳过
+        mExpired->owner = nullptr;
+        mRequests.forEach([this](auto const&, Entry const& entry) { mTimerService.cancel(entry.timer); });
         auto& bus = ll::event::EventBus::getInstance();
         bus.removeListener(mPLayerDisconnectListener);
         bus.removeListener(mRequestAcceptedListener);
@@ -190,7 +224,7 @@ TpaRequestPool::~TpaRequestPool() = default;
 
 
 std::shared_ptr<TpaRequest> TpaRequestPool::createRequest(Player& sender, Player& receiver, TpaRequest::Type type) {
-    auto req = std::make_shared<TpaRequest>(sender, receiver, type);
+    auto req = TpaRequest::create(sender, receiver, type);
     mImpl->addRequestImpl(req);
     return req;
 }
@@ -215,32 +249,20 @@ std::shared_ptr<TpaRequest> TpaRequestPool::getRequest(mce::UUID const& sender,
 std::vector<mce::UUID> TpaRequestPool::getSenders(mce::UUID const& receiver) {
     std::shared_lock lock(mImpl->mMutex);
 
-    auto iter = mImpl->mForwardMap.find(receiver);
-    if (iter == mImpl->mForwardMap.end()) {
-        return {};
-    }
-
     std::vector<mce::UUID> senders;
-    senders.reserve(iter->second.size());
-    for (auto& [sender, req] : iter->second) {
+    mImpl->mRequests.forEachBySecond(receiver, [&](mce::UUID const& sender, Impl::Entry const&) {
         senders.push_back(sender);
-    }
+    });
     return senders;
 }
 
 std::vector<std::shared_ptr<TpaRequest>> TpaRequestPool::getInitiatedRequest(mce::UUID const& sender) {
     std::shared_lock lock(mImpl->mMutex);
 
-    auto iter = mImpl->mReverseMap.find(sender);
-    if (iter == mImpl->mReverseMap.end()) {
-        return {};
-    }
-
     std::vector<std::shared_ptr<TpaRequest>> requests;
-    requests.reserve(iter->second.size());
-    for (auto& [receiver, req] : iter->second) {
-        requests.push_back(req);
-    }
+    mImpl->mRequests.forEachByFirst(sender, [&](mce::UUID const&, Impl::Entry const& entry) {
+        requests.push_back(entry.request);
+    });
     return requests;
 }
 
@@ -248,5 +270,10 @@ std::vector<std::shared_ptr<TpaRequest>> TpaRequestPool::getInitiatedRequest(Pla
     return getInitiatedRequest(sender.getUuid());
 }
 
+TpaRequestPool::ExpirationStats TpaRequestPool::getExpirationStats() const {
+    std::lock_guard lock{mImpl->mStatsMutex};
+    return mImpl->mExpirationStats;
+}
+
 
 } // namespace ltps::tpa
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "TpaRequest.h"
 #include "ltps/Global.h"
 #include "mc/platform/UUID.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -9,6 +12,20 @@
 namespace ltps::tpa {
 
 class TpaRequestPool {
+public:
+    // 过期请求按批次在服务器线程中发布, 用于衡量对 tick 耗时的影响
+    struct ExpirationStats {
+        std::uint64_t             batches{0};   // 发布批次数 (每个批次占用一次服务器线程调度)
+        std::uint64_t             expired{0};   // 到期的请求数
+        std::uint64_t             published{0}; // 发布了过期事件的请求数 (不含已被处理的请求)
+        std::size_t               lastBatch{0}; // 上一批次的请求数
+        std::size_t               maxBatch{0};  // 单批次最多请求数
+        std::chrono::microseconds lastTime{0};  // 上一批次在服务器线程中的耗时
+        std::chrono::microseconds maxTime{0};   // 单批次最长耗时
+        std::chrono::microseconds totalTime{0}; // 累计耗时
+    };
+
+private:
     struct Impl;
     std::unique_ptr<Impl> mImpl;
 
@@ -32,6 +49,8 @@ class TpaRequestPool {
 
     TPSNDAPI std::vector<std::shared_ptr<TpaRequest>> getInitiatedRequest(mce::UUID const& sender);
     TPSNDAPI std::vector<std::shared_ptr<TpaRequest>> getInitiatedRequest(Player& sender);
+
+    TPSNDAPI ExpirationStats getExpirationStats() const;
 };
 
 
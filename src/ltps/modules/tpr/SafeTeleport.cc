@@ -191,28 +191,20 @@ void SafeTeleport::Task::launchFindPosTask(ll::thread::ServerThreadExecutor cons
 
 SafeTeleport::SafeTeleport(ll::thread::ServerThreadExecutor const& serverThreadExecutor)
 : mServerThreadExecutor(serverThreadExecutor) {
-    mInterruptableSleep = std::make_shared<ll::coro::InterruptableSleep>();
-    mPollingAbortFlag   = std::make_shared<std::atomic_bool>(false);
-
-    ll::coro::keepThis([this, sleep = mInterruptableSleep, abortFlag = mPollingAbortFlag]() -> ll::coro::CoroTask<> {
-        while (!abortFlag->load()) {
-            co_await sleep->sleepFor(ll::chrono::ticks{10});
-            if (abortFlag->load()) break;
-            try {
-                polling();
-            } catch (...) {
-                TeleportSystem::getInstance().getSelf().getLogger().error(
-                    "An exception occurred while polling SafeTeleport tasks"
-                );
-            }
+    // 每 10 tick 在服务器线程轮询一次任务状态
+    mPollingTimer = TeleportSystem::getInstance().getTimerService().scheduleEveryTicks(ll::chrono::ticks{10}, [this] {
+        try {
+            polling();
+        } catch (...) {
+            TeleportSystem::getInstance().getSelf().getLogger().error(
+                "An exception occurred while polling SafeTeleport tasks"
+            );
         }
-        co_return;
-    }).launch(serverThreadExecutor.getDefault());
+    });
 }
 
 SafeTeleport::~SafeTeleport() {
-    mPollingAbortFlag->store(true);
-    mInterruptableSleep->interrupt(true);
+    TeleportSystem::getInstance().getTimerService().cancel(mPollingTimer);
     for (auto& [_, task] : mTasks) {
         task->abort();
     }
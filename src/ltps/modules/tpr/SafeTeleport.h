@@ -1,10 +1,10 @@
 #pragma once
 #include "ltps/Global.h"
+#include "ltps/common/TimerService.h"
 #include "mc/deps/core/math/Vec3.h"
 #include "mc/deps/ecs/WeakEntityRef.h"
 #include <cstdint>
 #include <ll/api/coro/CoroTask.h>
-#include <ll/api/coro/InterruptableSleep.h>
 #include <ll/api/thread/ServerThreadExecutor.h>
 #include <mc/network/packet/SetTitlePacket.h>
 #include <mc/world/level/ChunkPos.h>
@@ -126,9 +126,8 @@ class SafeTeleport {
 
     std::unordered_map<TaskId, SharedTask> mTasks;
 
-    ll::thread::ServerThreadExecutor const&       mServerThreadExecutor;
-    std::shared_ptr<ll::coro::InterruptableSleep> mInterruptableSleep{nullptr};
-    std::shared_ptr<std::atomic_bool>             mPollingAbortFlag{nullptr};
+    ll::thread::ServerThreadExecutor const& mServerThreadExecutor;
+    TimerService::TimerId                   mPollingTimer{TimerService::InvalidTimer};
 };
 
 } // namespace ltps::tpr
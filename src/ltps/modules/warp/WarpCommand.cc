@@ -10,6 +10,8 @@
 #include "ltps/utils/McUtils.h"
 #include <ll/api/command/CommandHandle.h>
 #include <mc/world/level/dimension/VanillaDimensions.h>
+#include <algorithm>
+#include <cstddef>
 
 
 namespace ltps::warp {
@@ -18,6 +20,12 @@ struct WarpListParam {
     std::string name;
 };
 
+struct WarpNearParam {
+    int count = 5;
+};
+
+constexpr int MAX_NEAR_COUNT = 20; // warp near 单条消息最多列出的传送点数
+
 struct WarpActionParam {
     enum class Action { Add, Remove, Go };
     Action      action;
@@ -75,13 +83,40 @@ void WarpCommand::setup() {
                     warp->y,
                     warp->z,
                     VanillaDimensions::toString(warp->dimid),
-                    warp->createdTime,
-                    warp->modifiedTime
+                    warp->getCreatedTimeString(),
+                    warp->getModifiedTimeString()
                 )
             );
         }
     );
 
+    // warp near [count]
+    cmd.overload<WarpNearParam>().text("near").optional("count").execute(
+        [](CommandOrigin const& origin, CommandOutput& output, WarpNearParam const& param) {
+            if (origin.getOriginType() != CommandOriginType::Player) {
+                mc_utils::sendText<mc_utils::Error>(output, "此命令只能由玩家执行"_tr());
+                return;
+            }
+
+            auto& player     = *static_cast<Player*>(origin.getEntity());
+            auto  localeCode = player.getLocaleCode();
+            auto  storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+
+            auto count = static_cast<std::size_t>(std::clamp(param.count, 1, MAX_NEAR_COUNT));
+            auto hits  = storage->getNearestWarps(player.getDimensionId(), player.getPosition(), count);
+            if (hits.empty()) {
+                mc_utils::sendText<mc_utils::Error>(output, "当前维度没有公共传送点"_trl(localeCode));
+                return;
+            }
+
+            std::string text = "距离最近的 {} 个公共传送点:"_trl(localeCode, hits.size());
+            for (auto const& hit : hits) {
+                text += "\n{} - {:.1f}m"_trl(localeCode, hit.key, hit.distance);
+            }
+            mc_utils::sendText<mc_utils::Info>(output, text);
+        }
+    );
+
     // warp <add|remove|go> <name>
     cmd.overload<WarpActionParam>().required("action").required("name").execute(
         [](CommandOrigin const& origin, CommandOutput& output, WarpActionParam const& param) {
@@ -39,14 +39,14 @@ bool WarpModule::enable() {
                 throw std::runtime_error("WarpStorage not found");
             }
 
-            auto warp = storage->getWarp(name);
-            if (!warp) {
+            auto handle = storage->findWarp(name);
+            if (!handle) {
                 mc_utils::sendText<mc_utils::Error>(player, "公共传送点 {} 不存在"_trl(localeCode, name));
                 ev.cancel();
                 return;
             }
 
-            auto teleporting = WarpTeleportingEvent(player, warp.value());
+            auto teleporting = WarpTeleportingEvent(player, *storage, *handle);
             bus.publish(teleporting);
 
             if (teleporting.isCancelled()) {
@@ -54,12 +54,21 @@ bool WarpModule::enable() {
                 return;
             }
 
+            // 监听器可能修改了传送点, 重新解析句柄
+            auto warp = storage->resolve(*handle);
+            if (!warp) {
+                mc_utils::sendText<mc_utils::Error>(player, "公共传送点 {} 不存在"_trl(localeCode, name));
+                ev.cancel();
+                return;
+            }
             warp->teleport(player);
 
-            auto teleported = WarpTeleportedEvent(player, warp.value());
+            // 监听器可能删除或改名该记录, 回调使用事件发布前的副本
+            auto target     = *warp;
+            auto teleported = WarpTeleportedEvent(player, *storage, *handle);
 
             bus.publish(teleported);
-            ev.invokeCallback(warp.value());
+            ev.invokeCallback(target);
         },
         ll::event::EventPriority::High
     ));
@@ -69,6 +78,12 @@ bool WarpModule::enable() {
             auto  realName   = player.getRealName();
             auto  localeCode = player.getLocaleCode();
 
+            auto warp = ev.getWarp();
+            if (!warp) {
+                ev.cancel(); // 前面的监听器删除了该传送点
+                return;
+            }
+
             auto& cooldown = getCooldown();
 
             if (cooldown.isCooldown(realName)) {
@@ -81,7 +96,7 @@ bool WarpModule::enable() {
             }
 
             auto cl = PriceCalculate(getConfig().modules.warp.goWarpCalculate);
-            cl.addVariable("dimid", ev.getWarp().dimid);
+            cl.addVariable("dimid", warp->dimid);
             auto price = cl.eval();
 
             if (!price) {
@@ -89,7 +104,7 @@ bool WarpModule::enable() {
                 TeleportSystem::getInstance().getSelf().getLogger().error(
                     "[WarpModule]: Calculate price failed! player: {}, warpName: {}, error: {}",
                     realName,
-                    ev.getWarp().name,
+                    warp->name,
                     price.error()
                 );
                 ev.cancel();
@@ -0,0 +1,255 @@
+#include "ltps/modules/warp/WarpSearchIndex.h"
+#include "ltps/utils/StringUtils.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+
+namespace ltps::warp {
+
+namespace {
+
+std::uint64_t packBigram(char32_t first, char32_t second) {
+    return (static_cast<std::uint64_t>(first) << 32) | static_cast<std::uint64_t>(second);
+}
+
+std::vector<std::uint64_t> distinctBigrams(std::u32string const& str) {
+    std::vector<std::uint64_t> grams;
+    for (std::size_t i = 1; i < str.size(); ++i) {
+        grams.push_back(packBigram(str[i - 1], str[i]));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+std::vector<char32_t> distinctUnigrams(std::u32string const& str) {
+    std::vector<char32_t> grams{str.begin(), str.end()};
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+template <typename Map, typename Key>
+void updatePosting(Map& map, Key const& key, WarpSearchIndex::EntryId id, bool insert) {
+    if (insert) {
+        auto& list = map[key];
+        list.insert(std::lower_bound(list.begin(), list.end(), id), id);
+        return;
+    }
+    auto iter = map.find(key);
+    if (iter == map.end()) {
+        return;
+    }
+    auto& list = iter->second;
+    if (auto pos = std::lower_bound(list.begin(), list.end(), id); pos != list.end() && *pos == id) {
+        list.erase(pos);
+    }
+    if (list.empty()) {
+        map.erase(iter);
+    }
+}
+
+// 编辑距离阈值: 关键字越长允许的错误越多, 过短的关键字不做模糊匹配
+std::uint32_t fuzzyThreshold(std::size_t length) {
+    if (length < 3) {
+        return 0;
+    }
+    return length < 6 ? 1 : 2;
+}
+
+} // namespace
+
+
+void WarpSearchIndex::indexGrams(EntryId id, bool insert) {
+    auto const& folded = mEntries[id].folded;
+    for (auto gram : distinctUnigrams(folded)) {
+        updatePosting(mUnigrams, gram, id, insert);
+    }
+    for (auto gram : distinctBigrams(folded)) {
+        updatePosting(mBigrams, gram, id, insert);
+    }
+}
+
+void WarpSearchIndex::add(std::string const& name) {
+    if (mIds.contains(name)) {
+        return;
+    }
+    EntryId id;
+    if (!mFreeIds.empty()) {
+        id = mFreeIds.back();
+        mFreeIds.pop_back();
+    } else {
+        id = static_cast<EntryId>(mEntries.size());
+        mEntries.emplace_back();
+    }
+    auto& entry  = mEntries[id];
+    entry.name   = name;
+    entry.folded = string_utils::decodeUtf8Folded(name);
+    entry.alive  = true;
+    mIds.emplace(name, id);
+    indexGrams(id, true);
+}
+
+void WarpSearchIndex::remove(std::string const& name) {
+    auto iter = mIds.find(name);
+    if (iter == mIds.end()) {
+        return;
+    }
+    auto id = iter->second;
+    indexGrams(id, false);
+    mIds.erase(iter);
+
+    auto& entry = mEntries[id];
+    entry.alive = false;
+    entry.name.clear();
+    entry.folded.clear();
+    mFreeIds.push_back(id);
+}
+
+void WarpSearchIndex::clear() {
+    mEntries.clear();
+    mFreeIds.clear();
+    mIds.clear();
+    mBigrams.clear();
+    mUnigrams.clear();
+}
+
+std::vector<WarpSearchIndex::Match> WarpSearchIndex::search(std::string_view keyword, std::size_t limit) const {
+    auto query = string_utils::decodeUtf8Folded(keyword);
+    if (query.empty() || limit == 0) {
+        return {};
+    }
+
+    std::vector<Match>         matches;
+    std::vector<EntryId>       candidates; // 子串候选 (按 id 有序)
+    std::vector<std::uint64_t> queryBigrams = distinctBigrams(query);
+    if (query.size() == 1) {
+        if (auto iter = mUnigrams.find(query.front()); iter != mUnigrams.end()) {
+            candidates = iter->second;
+        }
+    } else {
+        // 取所有二元组倒排表的交集, 从最短的开始
+        std::vector<std::vector<EntryId> const*> lists;
+        for (auto gram : queryBigrams) {
+            auto iter = mBigrams.find(gram);
+            if (iter == mBigrams.end()) {
+                lists.clear();
+                break;
+            }
+            lists.push_back(&iter->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](auto* lhs, auto* rhs) { return lhs->size() < rhs->size(); });
+        if (!lists.empty()) {
+            candidates = *lists.front();
+        }
+        for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+            std::vector<EntryId> next;
+            std::set_intersection(
+                candidates.begin(),
+                candidates.end(),
+                lists[i]->begin(),
+                lists[i]->end(),
+                std::back_inserter(next)
+            );
+            candidates = std::move(next);
+        }
+    }
+
+    for (auto id : candidates) {
+        auto const& folded = mEntries[id].folded;
+        if (folded == query) {
+            matches.push_back({id, MatchKind::Exact, 0});
+        } else if (folded.starts_with(query)) {
+            matches.push_back({id, MatchKind::Prefix, 0});
+        } else if (folded.find(query) != std::u32string::npos) {
+            matches.push_back({id, MatchKind::Substring, 0});
+        }
+    }
+
+    std::vector<EntryId> matched; // 已匹配的 id (按 id 有序)
+    for (auto const& match : matches) {
+        matched.push_back(match.id);
+    }
+
+    // 模糊匹配: 与关键字共享至少一个二元组 (短关键字也考虑一元组) 且长度相近的名称
+    if (auto threshold = fuzzyThreshold(query.size()); threshold > 0) {
+        std::vector<EntryId> pool;
+        auto                 collect = [&](std::vector<EntryId> const& list) {
+            pool.insert(pool.end(), list.begin(), list.end());
+        };
+        for (auto gram : queryBigrams) {
+            if (auto iter = mBigrams.find(gram); iter != mBigrams.end()) {
+                collect(iter->second);
+            }
+        }
+        if (query.size() <= 4) {
+            for (auto gram : distinctUnigrams(query)) {
+                if (auto iter = mUnigrams.find(gram); iter != mUnigrams.end()) {
+                    collect(iter->second);
+                }
+            }
+        }
+        std::sort(pool.begin(), pool.end());
+        pool.erase(std::unique(pool.begin(), pool.end()), pool.end());
+
+        for (auto id : pool) {
+            auto const& folded = mEntries[id].folded;
+            auto        diff   = std::max(folded.size(), query.size()) - std::min(folded.size(), query.size());
+            if (diff > threshold || std::binary_search(matched.begin(), matched.end(), id)) {
+                continue; // 长度相差过大, 或已作为子串匹配
+            }
+            if (auto distance = editDistance(folded, query, threshold); distance <= threshold) {
+                matches.push_back({id, MatchKind::Fuzzy, distance});
+            }
+        }
+    }
+
+    auto rank = [&](Match const& lhs, Match const& rhs) {
+        if (lhs.kind != rhs.kind) return lhs.kind < rhs.kind;
+        if (lhs.distance != rhs.distance) return lhs.distance < rhs.distance;
+        auto const& l = mEntries[lhs.id];
+        auto const& r = mEntries[rhs.id];
+        if (l.folded.size() != r.folded.size()) return l.folded.size() < r.folded.size();
+        return l.name < r.name;
+    };
+    if (matches.size() > limit) {
+        std::partial_sort(matches.begin(), matches.begin() + static_cast<std::ptrdiff_t>(limit), matches.end(), rank);
+        matches.resize(limit);
+    } else {
+        std::sort(matches.begin(), matches.end(), rank);
+    }
+    return matches;
+}
+
+std::uint32_t
+WarpSearchIndex::editDistance(std::u32string_view lhs, std::u32string_view rhs, std::uint32_t maxDistance) {
+    if (lhs.size() < rhs.size()) {
+        std::swap(lhs, rhs);
+    }
+    if (lhs.size() - rhs.size() > maxDistance) {
+        return maxDistance + 1;
+    }
+
+    std::vector<std::uint32_t> prev(rhs.size() + 1), curr(rhs.size() + 1);
+    for (std::size_t j = 0; j <= rhs.size(); ++j) {
+        prev[j] = static_cast<std::uint32_t>(j);
+    }
+    for (std::size_t i = 1; i <= lhs.size(); ++i) {
+        curr[0]          = static_cast<std::uint32_t>(i);
+        std::uint32_t lo = curr[0];
+        for (std::size_t j = 1; j <= rhs.size(); ++j) {
+            auto cost = lhs[i - 1] == rhs[j - 1] ? 0u : 1u;
+            curr[j]   = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
+            lo        = std::min(lo, curr[j]);
+        }
+        if (lo > maxDistance) {
+            return maxDistance + 1; // 整行都已超出阈值, 提前结束
+        }
+        std::swap(prev, curr);
+    }
+    return std::min(prev[rhs.size()], maxDistance + 1);
+}
+
+
+} // namespace ltps::warp
@@ -0,0 +1,75 @@
+#pragma once
+#include "ltps/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ltps::warp {
+
+/**
+ * @brief 传送点名称的模糊搜索索引
+ * 名称按 UTF-8 解码为码点 (ASCII 不区分大小写) 后建立一元与二元 (n = 2) 倒排表:
+ *  - 关键字只有一个字符时查一元表，否则取关键字所有二元组倒排表的交集作为子串候选
+ *  - 编辑距离候选取与关键字至少共享一个二元组 (或一元组) 且长度相近的名称
+ *
+ * 结果按 精确 > 前缀 > 子串 > 编辑距离 排序，同级按名称长度与名称排序。
+ * 索引只在服务器线程访问，随 WarpStorage 的增删改增量维护。
+ */
+class WarpSearchIndex {
+public:
+    using EntryId = std::uint32_t;
+
+    enum class MatchKind : std::uint8_t {
+        Exact,     // 完全相同
+        Prefix,    // 名称以关键字开头
+        Substring, // 名称包含关键字
+        Fuzzy,     // 编辑距离在阈值内
+    };
+
+    // 轻量的搜索结果, 通过 getName(id) 取得名称; 索引修改后 id 可能被复用, 不应长期保存
+    struct Match {
+        EntryId       id;
+        MatchKind     kind;
+        std::uint32_t distance; // 仅 Fuzzy 有意义
+    };
+
+private:
+    struct Entry {
+        std::string    name;
+        std::u32string folded; // 解码并折叠大小写后的码点
+        bool           alive{false};
+    };
+
+    std::vector<Entry>                                      mEntries;
+    std::vector<EntryId>                                    mFreeIds;
+    std::unordered_map<std::string, EntryId>                mIds;      // 名称 -> EntryId
+    std::unordered_map<std::uint64_t, std::vector<EntryId>> mBigrams;  // 二元组 -> 包含它的名称 (按 id 有序)
+    std::unordered_map<char32_t, std::vector<EntryId>>      mUnigrams; // 码点 -> 包含它的名称 (按 id 有序)
+
+    void indexGrams(EntryId id, bool insert);
+
+public:
+    TPSAPI void add(std::string const& name);
+    TPSAPI void remove(std::string const& name);
+    TPSAPI void clear();
+
+    [[nodiscard]] bool contains(std::string const& name) const { return mIds.contains(name); }
+
+    [[nodiscard]] std::size_t size() const { return mIds.size(); }
+
+    [[nodiscard]] std::string const& getName(EntryId id) const { return mEntries[id].name; }
+
+    // 按相关度排序返回至多 limit 个结果
+    TPSNDAPI std::vector<Match> search(std::string_view keyword, std::size_t limit) const;
+
+    // 码点级编辑距离 (Levenshtein), 超过 maxDistance 时返回 maxDistance + 1
+    TPSNDAPI static std::uint32_t
+    editDistance(std::u32string_view lhs, std::u32string_view rhs, std::uint32_t maxDistance);
+};
+
+
+} // namespace ltps::warp
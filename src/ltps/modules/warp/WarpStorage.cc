@@ -1,92 +1,293 @@
 #include "WarpStorage.h"
 #include "ltps/TeleportSystem.h"
-#include "ltps/utils/JsonUtls.h"
+#include "ltps/utils/BinaryUtils.h"
+#include "ltps/utils/JsonSaxReader.h"
 #include "ltps/utils/McUtils.h"
 #include "ltps/utils/TimeUtils.h"
 #include "mc/deps/core/math/Vec3.h"
 #include "mc/world/actor/player/Player.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
-#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 
 namespace ltps::warp {
 
+namespace {
+
+using WarpSaxReader = json_utils::RecordSaxReader<WarpStorage::Warp>;
+
+void assignWarpField(WarpStorage::Warp& warp, std::string_view field, WarpSaxReader::Value const& value) {
+    if (field == "x") {
+        json_utils::assignNumber(warp.x, value);
+    } else if (field == "y") {
+        json_utils::assignNumber(warp.y, value);
+    } else if (field == "z") {
+        json_utils::assignNumber(warp.z, value);
+    } else if (field == "dimid") {
+        json_utils::assignNumber(warp.dimid, value);
+    } else if (field == "name") {
+        json_utils::assignString(warp.name, value);
+    } else if (field == "createdTime") {
+        json_utils::assignEpoch(warp.createdTime, value);
+    } else if (field == "modifiedTime") {
+        json_utils::assignEpoch(warp.modifiedTime, value);
+    }
+}
+
+} // namespace
+
+
 WarpStorage::WarpStorage() = default;
 
 void WarpStorage::load() {
     auto& db = getDatabase();
 
     if (!db.has(STORAGE_KEY)) {
-        db.set(STORAGE_KEY, "[]");
+        db.set(STORAGE_KEY, encodeWarps({}));
     }
 
-    auto rawJson = db.get(STORAGE_KEY);
-    if (!rawJson) {
+    auto rawData = db.get(STORAGE_KEY);
+    if (!rawData) {
         throw std::runtime_error("Could not load warp data");
     }
 
     try {
-        auto json = nlohmann::json::parse(rawJson.value());
-        if (!json.is_array()) {
-            throw std::runtime_error("Could not parse warp data");
-        }
+        auto warps = decodeWarps(rawData.value());
+        mergeJournaled(warps);
+        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} warps", warps.size());
 
-        for (auto& [key, value] : json.items()) {
-            Warp warp;
-            json_utils::json2structTryPatch(warp, value);
-            mWarps.push_back(std::move(warp));
+        clearWarps();
+        for (auto& warp : warps) {
+            insertWarp(std::move(warp));
         }
-        TeleportSystem::getInstance().getSelf().getLogger().info("Loaded {} warps", mWarps.size());
-    } catch (const nlohmann::json::parse_error& e) {
-        throw std::runtime_error("Could not parse warp data");
+        auto snapshot = std::make_shared<Warps const>(mWarps);
+
+        std::lock_guard lock{mMutex};
+        mSnapshot = std::move(snapshot);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string{"Could not parse warp data, "} + e.what());
     }
 }
 
-void WarpStorage::unload() { writeBack(); }
+// v1: [header][count: varint] { [x, y, z: f32][dimid: i32][name][createdTime][modifiedTime] } * count
+// v2: 同 v1, 但 createdTime / modifiedTime 为 i64 Unix 时间戳
+std::string WarpStorage::encodeWarps(Warps const& warps) {
+    binary_utils::Writer writer{8 + warps.size() * 48};
+    writer.writeHeader(BINARY_VERSION).writeVarUInt(warps.size());
+    for (auto const& warp : warps) {
+        writer.writeF32(warp.x).writeF32(warp.y).writeF32(warp.z).writeI32(warp.dimid);
+        writer.writeString(warp.name).writeI64(warp.createdTime).writeI64(warp.modifiedTime);
+    }
+    return writer.release();
+}
+
+WarpStorage::Warps WarpStorage::decodeWarps(std::string_view data) {
+    Warps warps;
+    if (!binary_utils::isBinary(data)) {
+        // 旧版 JSON 数据, 时间字段为字符串
+        auto onRecords = [&](std::string_view, Warps records) { warps = std::move(records); };
+        WarpSaxReader{WarpSaxReader::Layout::Array, assignWarpField, onRecords}.parse(data);
+        return warps;
+    }
 
-void WarpStorage::writeBack() {
-    auto& db   = getDatabase();
-    auto  json = json_utils::struct2json(mWarps);
-    db.set(STORAGE_KEY, json.dump());
+    binary_utils::Reader reader{data};
+    auto                 version = reader.readHeader();
+    if (version != 1 && version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported warp data version: " + std::to_string(version));
+    }
+    auto readTime = [&]() -> std::int64_t {
+        return version == 1 ? time_utils::parseEpoch(reader.readString()) : reader.readI64();
+    };
+
+    auto count = reader.readVarUInt();
+    warps.reserve(std::min<std::size_t>(count, data.size() / 19)); // 单条记录至少 19 字节
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Warp warp{};
+        warp.x            = reader.readF32();
+        warp.y            = reader.readF32();
+        warp.z            = reader.readF32();
+        warp.dimid        = reader.readI32();
+        warp.name         = reader.readString();
+        warp.createdTime  = readTime();
+        warp.modifiedTime = readTime();
+        warps.push_back(std::move(warp));
+    }
+    return warps;
 }
 
-bool WarpStorage::hasWarp(std::string const& name) const {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return name == warp.name; });
-    return it != mWarps.end();
+void WarpStorage::unload() {
+    clearWarps();
+    std::lock_guard lock{mMutex};
+    mSnapshot.reset();
 }
 
+void WarpStorage::writeBack(StorageBatch& batch) {
+    std::shared_ptr<Warps const> snapshot;
+    {
+        std::lock_guard lock{mMutex};
+        snapshot = mSnapshot;
+    }
+    if (snapshot) {
+        batch.set(STORAGE_KEY, encodeWarps(*snapshot)); // 在回写线程编码, 不占用服务器线程
+    }
+}
+
+void WarpStorage::commitChanges() {
+    std::shared_ptr<Warps const> next = std::make_shared<Warps const>(mWarps); // 写时复制
+    {
+        std::lock_guard lock{mMutex};
+        mSnapshot.swap(next);
+    }
+    markDirty(); // 旧快照在 next 析构时释放 (若回写线程仍持有则由其释放)
+}
+
+void WarpStorage::journalWarp(std::string const& name) {
+    auto key = std::string{JOURNAL_PREFIX} + name;
+    if (auto handle = findWarp(name)) {
+        journalSet(key, encodeWarps({*resolve(*handle)}));
+    } else {
+        journalSet(key, {}); // 空值表示已删除, 加载时需要从主数据中移除
+    }
+}
+
+void WarpStorage::mergeJournaled(Warps& warps) {
+    std::vector<std::string> keys;
+    forEachWithPrefix(JOURNAL_PREFIX, [&](std::string_view name, std::string_view value) {
+        keys.emplace_back(name);
+        std::erase_if(warps, [&](Warp const& warp) { return warp.name == name; });
+        if (!value.empty()) {
+            for (auto& warp : decodeWarps(value)) {
+                warps.push_back(std::move(warp));
+            }
+        }
+    });
+    if (keys.empty()) {
+        return;
+    }
+
+    // 先写入合并后的主数据再删除日志记录, 中途失败时下次加载会重新合并 (结果相同)
+    auto& db = getDatabase();
+    if (!db.set(STORAGE_KEY, encodeWarps(warps))) {
+        throw std::runtime_error("Could not save merged warp data");
+    }
+    for (auto const& name : keys) {
+        if (!db.del(JOURNAL_PREFIX + name)) {
+            throw std::runtime_error("Could not delete journaled warp: " + name);
+        }
+    }
+    TeleportSystem::getInstance().getSelf().getLogger().info("Merged {} journaled warps", keys.size());
+}
+
+void WarpStorage::clearWarps() {
+    mWarps.clear();
+    mSlots.clear();
+    mHandles.clear();
+    mByName.clear();
+    mIndex.clear();
+    mGrid.clear();
+    mCoords.clear();
+}
+
+void WarpStorage::insertWarp(Warp warp) {
+    auto handle = mSlots.insert(static_cast<std::uint32_t>(mWarps.size()));
+    mHandles.push_back(handle);
+    mByName.emplace(warp.name, handle);
+    mIndex.add(warp.name);
+    mGrid.insert(warp.name, warp.dimid, warp.x, warp.y, warp.z);
+    mCoords.push_back(warp.dimid, warp.x, warp.y, warp.z);
+    mWarps.push_back(std::move(warp));
+}
+
+bool WarpStorage::hasWarp(std::string const& name) const { return mByName.contains(name); }
+
 Result<void> WarpStorage::addWarp(Warp warp) {
     if (hasWarp(warp.name)) {
         return std::unexpected("Warp name repeated");
     }
-    mWarps.emplace_back(warp);
+    auto name = warp.name;
+    insertWarp(std::move(warp));
+    commitChanges();
+    journalWarp(name);
     return {};
 }
 
 Result<void> WarpStorage::updateWarp(std::string const& name, Warp warp) {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    auto iter = mByName.find(name);
+    if (iter == mByName.end()) {
         return std::unexpected("Warp not found");
     }
-    it->updateModifiedTime();
-    *it = std::move(warp);
+    if (warp.name != name && hasWarp(warp.name)) {
+        return std::unexpected("Warp name repeated");
+    }
+    auto handle = iter->second;
+    if (warp.name != name) {
+        mByName.erase(iter);
+        mByName.emplace(warp.name, handle); // 改名后句柄不变
+    }
+    mIndex.remove(name);
+    mIndex.add(warp.name);
+    mGrid.erase(name);
+    mGrid.insert(warp.name, warp.dimid, warp.x, warp.y, warp.z);
+
+    auto index = *mSlots.get(handle);
+    mCoords.set(index, warp.dimid, warp.x, warp.y, warp.z);
+
+    auto& target = mWarps[index];
+    target.updateModifiedTime();
+    target = std::move(warp);
+    commitChanges();
+    if (target.name != name) {
+        journalWarp(name); // 改名: 旧名称记为删除
+    }
+    journalWarp(target.name);
     return {};
 }
 
 Result<void> WarpStorage::removeWarp(std::string const& name) {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    auto iter = mByName.find(name);
+    if (iter == mByName.end()) {
         return std::unexpected("Warp not found");
     }
-    mWarps.erase(it);
+    auto handle = iter->second;
+    auto index  = *mSlots.get(handle);
+    mWarps.erase(mWarps.begin() + index);
+    mCoords.erase(index);
+    mHandles.erase(mHandles.begin() + index);
+    for (auto i = index; i < mHandles.size(); ++i) {
+        *mSlots.get(mHandles[i]) = i; // 后续记录前移一位
+    }
+    mSlots.erase(handle);
+    mByName.erase(iter);
+    mIndex.remove(name);
+    mGrid.erase(name);
+    commitChanges();
+    journalWarp(name);
     return {};
 }
 
 std::optional<WarpStorage::Warp> WarpStorage::getWarp(std::string const& name) const {
-    auto it = std::find_if(mWarps.begin(), mWarps.end(), [&](Warp const& warp) { return warp.name == name; });
-    if (it == mWarps.end()) {
+    if (auto handle = findWarp(name)) {
+        return *resolve(*handle);
+    }
+    return std::nullopt;
+}
+
+std::optional<WarpStorage::WarpHandle> WarpStorage::findWarp(std::string const& name) const {
+    auto iter = mByName.find(name);
+    if (iter == mByName.end()) {
         return std::nullopt;
     }
-    return *it;
+    return iter->second;
+}
+
+WarpStorage::Warp const* WarpStorage::resolve(WarpHandle handle) const {
+    auto index = mSlots.get(handle);
+    return index ? &mWarps[*index] : nullptr;
 }
 
 WarpStorage::Warps const& WarpStorage::getWarps() const { return mWarps; }
@@ -109,32 +310,59 @@ std::vector<WarpStorage::Warp> WarpStorage::getWarps(int count) const {
 
 WarpStorage::Warps WarpStorage::queryWarp(std::string const& keyword) const {
     Warps result;
-    for (auto const& warp : mWarps) {
-        if (warp.name.find(keyword) != std::string::npos) {
-            result.emplace_back(warp);
+    for (auto const& match : searchWarps(keyword, mIndex.size())) {
+        if (auto handle = findWarp(mIndex.getName(match.id))) {
+            result.emplace_back(*resolve(*handle));
         }
     }
     return result;
 }
 
+std::vector<WarpSearchIndex::Match> WarpStorage::searchWarps(std::string const& keyword, std::size_t limit) const {
+    return mIndex.search(keyword, limit);
+}
+
+WarpSearchIndex const& WarpStorage::getSearchIndex() const { return mIndex; }
+
+std::vector<WarpStorage::WarpHit>
+WarpStorage::getNearestWarps(int dimid, Vec3 const& pos, std::size_t limit, float maxDistance) const {
+    return mGrid.nearest(dimid, pos.x, pos.y, pos.z, limit, maxDistance);
+}
+
+std::vector<WarpStorage::WarpHit> WarpStorage::getWarpsInRadius(int dimid, Vec3 const& pos, float radius) const {
+    return mGrid.withinRadius(dimid, pos.x, pos.y, pos.z, radius);
+}
+
+std::vector<WarpStorage::WarpHandle> WarpStorage::getWarpsInBox(int dimid, Vec3 const& min, Vec3 const& max) const {
+    std::vector<std::uint32_t> indices;
+    mCoords.withinBox(dimid, min.x, min.y, min.z, max.x, max.y, max.z, indices);
+
+    std::vector<WarpHandle> result;
+    result.reserve(indices.size());
+    for (auto index : indices) {
+        result.push_back(mHandles[index]);
+    }
+    return result;
+}
+
 
 // Warp
 WarpStorage::Warp WarpStorage::Warp::make(Vec3 const& vec3, int dimid, std::string const& name) {
-    auto time = time_utils::getCurrentTimeString();
+    auto time = time_utils::getCurrentEpoch();
     return Warp{
         .x            = vec3.x,
         .y            = vec3.y,
         .z            = vec3.z,
         .dimid        = dimid,
         .createdTime  = time,
-        .modifiedTime = std::move(time),
+        .modifiedTime = time,
         .name         = name
     };
 }
 
 void WarpStorage::Warp::teleport(Player& player) const { player.teleport(Vec3{x, y, z}, dimid, player.getRotation()); }
 
-void WarpStorage::Warp::updateModifiedTime() { modifiedTime = time_utils::getCurrentTimeString(); }
+void WarpStorage::Warp::updateModifiedTime() { modifiedTime = time_utils::getCurrentEpoch(); }
 
 void WarpStorage::Warp::updatePosition(Vec3 const& vec3) {
     x = vec3.x;
@@ -145,6 +373,8 @@ std::string WarpStorage::Warp::toString() const { return "{} => {}"_tr(name, toP
 std::string WarpStorage::Warp::toPosString() const {
     return "{}({},{},{})"_tr(VanillaDimensions::toString(dimid), x, y, z);
 }
+std::string WarpStorage::Warp::getCreatedTimeString() const { return time_utils::epochToString(createdTime); }
+std::string WarpStorage::Warp::getModifiedTimeString() const { return time_utils::epochToString(modifiedTime); }
 
 
 } // namespace ltps::warp
\ No newline at end of file
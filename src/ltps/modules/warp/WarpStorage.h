@@ -1,5 +1,19 @@
 #pragma once
+#include "ltps/common/CoordinateColumns.h"
+#include "ltps/common/SlotMap.h"
+#include "ltps/common/SpatialGrid.h"
 #include "ltps/database/IStorage.h"
+#include "ltps/modules/warp/WarpSearchIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 class Vec3;
 class Player;
@@ -9,11 +23,11 @@ namespace ltps::warp {
 class WarpStorage final : public IStorage {
 public:
     struct Warp {
-        float       x, y, z;      // 位置
-        int         dimid;        // 维度
-        std::string createdTime;  // 创建时间
-        std::string modifiedTime; // 修改时间
-        std::string name;         // 名称
+        float        x, y, z;      // 位置
+        int          dimid;        // 维度
+        std::int64_t createdTime;  // 创建时间 (Unix 时间戳, 秒)
+        std::int64_t modifiedTime; // 修改时间 (Unix 时间戳, 秒)
+        std::string  name;         // 名称
 
         TPSNDAPI static Warp make(Vec3 const& vec3, int dimid, std::string const& name);
 
@@ -25,20 +39,43 @@ class WarpStorage final : public IStorage {
 
         TPSNDAPI std::string toString() const;
         TPSNDAPI std::string toPosString() const;
+        TPSNDAPI std::string getCreatedTimeString() const;  // 格式化为本地时间, 仅用于显示
+        TPSNDAPI std::string getModifiedTimeString() const; // 格式化为本地时间, 仅用于显示
     };
-    using Warps = std::vector<Warp>;
+    using Warps      = std::vector<Warp>;
+    using WarpHit    = SpatialGrid<std::string>::Hit;  // 传送点名称与距离
+    using WarpHandle = SlotMap<std::uint32_t>::Handle; // 修改 (含改名) 后仍指向同一传送点, 删除后失效
 
 private:
-    Warps mWarps;
+    // 以下成员只在服务器线程 (及加载期间) 访问
+    Warps                                       mWarps;   // 按创建顺序排列
+    SlotMap<std::uint32_t>                      mSlots;   // 句柄 -> mWarps 下标
+    std::vector<WarpHandle>                     mHandles; // mWarps 下标 -> 句柄
+    std::unordered_map<std::string, WarpHandle> mByName;  // 名称 -> 句柄
+    WarpSearchIndex                             mIndex;   // 名称搜索索引
+    SpatialGrid<std::string>                    mGrid;    // 坐标索引
+    CoordinateColumns                           mCoords;  // mWarps 坐标的列存副本, 下标与 mWarps 一致
+
+    std::shared_ptr<Warps const> mSnapshot; // 最近一次修改后的不可变快照, 回写线程编码后写入
+    mutable std::mutex           mMutex;    // 仅保护 mSnapshot 指针的替换与读取
+
+    void clearWarps();
+    void insertWarp(Warp warp);                // 追加到末尾并更新各索引
+    void commitChanges();                      // 发布当前数据的快照并标记为脏
+    void journalWarp(std::string const& name); // 将单个传送点的当前状态写入日志
+    void mergeJournaled(Warps& warps);         // 加载时合并重放到数据库的日志记录
 
 public:
     TPS_DISALLOW_COPY_AND_MOVE(WarpStorage);
 
     TPSAPI explicit WarpStorage();
 
+    inline static std::string name = "WarpStorage";
+    TPSNDAPI std::string getStorageName() const override { return name; }
+
     TPSAPI void load() override;
     TPSAPI void unload() override;
-    TPSAPI void writeBack() override;
+    TPSAPI void writeBack(StorageBatch& batch) override;
 
     TPSAPI bool hasWarp(std::string const& name) const;
 
@@ -48,15 +85,44 @@ class WarpStorage final : public IStorage {
 
     TPSNDAPI Result<void> removeWarp(std::string const& name);
 
-    TPSNDAPI std::optional<Warp> getWarp(std::string const& name) const;
+    TPSNDAPI std::optional<Warp> getWarp(std::string const& name) const; // 拷贝, 需要长期保存时使用
+
+    TPSNDAPI std::optional<WarpHandle> findWarp(std::string const& name) const;
+
+    // 句柄失效时返回 nullptr; 返回的引用在下一次增删改之前有效 (同一 tick 内), 不应跨 tick 保存
+    TPSNDAPI Warp const* resolve(WarpHandle handle) const;
 
     TPSNDAPI Warps const& getWarps() const;
 
     TPSNDAPI std::vector<Warp> getWarps(int count) const;
 
-    TPSNDAPI Warps queryWarp(std::string const& keyword) const; // 模糊查询
+    TPSNDAPI Warps queryWarp(std::string const& keyword) const; // 模糊查询, 按相关度排序并拷贝结果
+
+    // 模糊查询, 按相关度排序返回轻量句柄, 通过 getSearchIndex().getName(match.id) 取得名称
+    TPSNDAPI std::vector<WarpSearchIndex::Match> searchWarps(std::string const& keyword, std::size_t limit = 100) const;
+
+    TPSNDAPI WarpSearchIndex const& getSearchIndex() const;
+
+    // 同一维度内距离最近的至多 limit 个传送点, 按距离升序
+    TPSNDAPI std::vector<WarpHit> getNearestWarps(
+        int         dimid,
+        Vec3 const& pos,
+        std::size_t limit,
+        float       maxDistance = std::numeric_limits<float>::infinity()
+    ) const;
+
+    // 同一维度内半径范围内的所有传送点, 按距离升序
+    TPSNDAPI std::vector<WarpHit> getWarpsInRadius(int dimid, Vec3 const& pos, float radius) const;
+
+    // 同一维度内位于轴对齐包围盒 [min, max] (含边界) 内的所有传送点, 按创建顺序
+    TPSNDAPI std::vector<WarpHandle> getWarpsInBox(int dimid, Vec3 const& min, Vec3 const& max) const;
+
+    TPSNDAPI static std::string encodeWarps(Warps const& warps);    // 编码为二进制格式
+    TPSNDAPI static Warps       decodeWarps(std::string_view data); // 解码二进制格式, 兼容旧版 JSON
 
-    static inline constexpr auto STORAGE_KEY = "warp";
+    static inline constexpr auto         STORAGE_KEY    = "warp";
+    static inline constexpr auto         JOURNAL_PREFIX = "warp/"; // 日志记录 warp/<name>, 空值表示已删除
+    static inline constexpr std::uint8_t BINARY_VERSION = 2;       // v2: 时间改为 i64 时间戳
 };
 
 } // namespace ltps::warp
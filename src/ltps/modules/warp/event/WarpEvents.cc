@@ -78,26 +78,30 @@ PlayerRequestGoWarpEvent::PlayerRequestGoWarpEvent(Player& player, std::string n
 : IPlayerRequestActionEvent(player, std::move(name)),
   mCallback(std::move(callback)) {}
 
-void PlayerRequestGoWarpEvent::invokeCallback(warp::WarpStorage::Warp warp) const {
+void PlayerRequestGoWarpEvent::invokeCallback(warp::WarpStorage::Warp const& warp) const {
     if (mCallback) {
-        mCallback(mPlayer, mName, std::move(warp));
+        mCallback(mPlayer, mName, warp);
     }
 }
 
 // ITeleportWarpEvent
-ITeleportWarpEvent::ITeleportWarpEvent(Player& player, warp::WarpStorage::Warp const& warp)
+ITeleportWarpEvent::ITeleportWarpEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle)
 : mPlayer(player),
-  mWarp(warp) {}
+  mStorage(storage),
+  mHandle(handle) {}
+
+Player& ITeleportWarpEvent::getPlayer() const { return mPlayer; }
+
+warp::WarpStorage::Warp const* ITeleportWarpEvent::getWarp() const { return mStorage.resolve(mHandle); }
 
-Player&                        ITeleportWarpEvent::getPlayer() const { return mPlayer; }
-warp::WarpStorage::Warp const& ITeleportWarpEvent::getWarp() const { return mWarp; }
+WarpStorage::WarpHandle ITeleportWarpEvent::getHandle() const { return mHandle; }
 
 // WarpTeleportingEvent & WarpTeleportedEvent
-WarpTeleportingEvent::WarpTeleportingEvent(Player& player, warp::WarpStorage::Warp const& warp)
-: ITeleportWarpEvent(player, warp) {}
+WarpTeleportingEvent::WarpTeleportingEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle)
+: ITeleportWarpEvent(player, storage, handle) {}
 
-WarpTeleportedEvent::WarpTeleportedEvent(Player& player, warp::WarpStorage::Warp const& warp)
-: ITeleportWarpEvent(player, warp) {}
+WarpTeleportedEvent::WarpTeleportedEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle)
+: ITeleportWarpEvent(player, storage, handle) {}
 
 IMPL_EVENT_EMITTER(PlayerRequestGoWarpEvent);
 IMPL_EVENT_EMITTER(WarpTeleportingEvent);
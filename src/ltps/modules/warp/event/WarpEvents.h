@@ -31,34 +31,40 @@ class IPlayerRequestActionEvent {
  * 流程: PlayerRequestGoWarpEvent -> WarpTeleportingEvent -> Warp::teleport -> WarpTeleportedEvent
  */
 class PlayerRequestGoWarpEvent final : public Cancellable<Event>, public IPlayerRequestActionEvent {
-    using Callback = std::function<void(Player& player, std::string name, WarpStorage::Warp warp)>;
+    using Callback = std::function<void(Player& player, std::string name, WarpStorage::Warp const& warp)>;
     Callback mCallback;
 
 public:
     TPSAPI explicit PlayerRequestGoWarpEvent(Player& player, std::string name, Callback callback = nullptr);
 
-    TPSAPI void invokeCallback(WarpStorage::Warp warp) const;
+    TPSAPI void invokeCallback(WarpStorage::Warp const& warp) const;
 };
 
+/**
+ * 传送事件只携带传送点句柄, getWarp() 每次从 WarpStorage 解析, 不拷贝传送点。
+ * 若监听器在事件期间删除了该传送点, getWarp() 返回 nullptr。
+ */
 class ITeleportWarpEvent {
-    Player&                  mPlayer;
-    WarpStorage::Warp const& mWarp;
+    Player&                 mPlayer;
+    WarpStorage const&      mStorage;
+    WarpStorage::WarpHandle mHandle;
 
 public:
-    TPSAPI explicit ITeleportWarpEvent(Player& player, WarpStorage::Warp const& warp);
+    TPSAPI explicit ITeleportWarpEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle);
 
     TPSNDAPI Player& getPlayer() const;
-    TPSNDAPI WarpStorage::Warp const& getWarp() const;
+    TPSNDAPI WarpStorage::Warp const* getWarp() const; // 传送点已被删除时返回 nullptr
+    TPSNDAPI WarpStorage::WarpHandle  getHandle() const;
 };
 
 class WarpTeleportingEvent final : public Cancellable<Event>, public ITeleportWarpEvent {
 public:
-    TPSAPI explicit WarpTeleportingEvent(Player& player, WarpStorage::Warp const& warp);
+    TPSAPI explicit WarpTeleportingEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle);
 };
 
 class WarpTeleportedEvent final : public Event, public ITeleportWarpEvent {
 public:
-    TPSAPI explicit WarpTeleportedEvent(Player& player, WarpStorage::Warp const& warp);
+    TPSAPI explicit WarpTeleportedEvent(Player& player, WarpStorage const& storage, WarpStorage::WarpHandle handle);
 };
 
 
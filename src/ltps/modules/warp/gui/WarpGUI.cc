@@ -1,6 +1,7 @@
 #include "WarpGUI.h"
 
 #include "ltps/TeleportSystem.h"
+#include "ltps/common/FormPager.h"
 #include "ltps/modules/warp/event/WarpEvents.h"
 #include "ltps/utils/McUtils.h"
 
@@ -9,6 +10,22 @@
 
 namespace ltps::warp {
 
+namespace {
+
+// 按钮只保存名称, 点击时再取传送点, 期间被删除或修改也不会使用过期数据
+void appendWarpButton(BackSimpleForm& fm, std::string const& name, std::string label, WarpGUI::ChooseWarpCB cb) {
+    fm.appendButton(std::move(label), [name, cb = std::move(cb)](Player& self) {
+        auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+        auto handle  = storage->findWarp(name);
+        if (!handle) {
+            mc_utils::sendText<mc_utils::Error>(self, "公共传送点 {} 不存在"_trl(self.getLocaleCode(), name));
+            return;
+        }
+        cb(self, *storage->resolve(*handle));
+    });
+}
+
+} // namespace
 
 void WarpGUI::sendMainMenu(Player& player, BackCB backCB) {
     auto localeCode = player.getLocaleCode();
@@ -37,15 +54,11 @@ void WarpGUI::sendMainMenu(Player& player, BackCB backCB) {
 }
 
 void WarpGUI::sendChooseWarpGUI(Player& player, ChooseWarpCB callback) {
-    _sendChooseWarpGUI(
-        player,
-        TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>()->getWarps(),
-        std::move(callback)
-    );
+    _sendChooseWarpGUI(player, std::move(callback));
 }
 
 void WarpGUI::sendChooseNameGUI(Player& player, ChooseNameCB callback) {
-    sendChooseWarpGUI(player, [cb = std::move(callback)](Player& self, WarpStorage::Warp warp) {
+    sendChooseWarpGUI(player, [cb = std::move(callback)](Player& self, WarpStorage::Warp const& warp) {
         cb(self, warp.name);
     });
 }
@@ -63,28 +76,76 @@ void WarpGUI::_sendFuzzySearchGUI(Player& player, ChooseWarpCB callback) {
             mc_utils::sendText<mc_utils::Error>(self, "名称不能为空"_trl(self.getLocaleCode()));
             return;
         }
-        _sendChooseWarpGUI(
-            self,
-            TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>()->queryWarp(name),
-            std::move(cb)
-        );
+        _sendSearchResultGUI(self, std::move(name), std::move(cb));
     });
 }
 
-void WarpGUI::_sendChooseWarpGUI(Player& player, WarpStorage::Warps const& warps, ChooseWarpCB callback) {
-    auto localeCode = player.getLocaleCode();
-    auto fm         = BackSimpleForm::make<WarpGUI::sendMainMenu>(nullptr);
+void WarpGUI::_sendChooseWarpGUI(Player& player, ChooseWarpCB callback, std::size_t page) {
+    auto  localeCode = player.getLocaleCode();
+    auto& warps      = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>()->getWarps();
+
+    FormPager pager{warps.size(), page};
+
+    auto fm = BackSimpleForm::make<WarpGUI::sendMainMenu>(nullptr);
     fm.setTitle("Warp - 选择传送点"_trl(localeCode));
-    fm.setContent("请选择一个要前往的传送点"_trl(localeCode));
+    fm.setContent("请选择一个要前往的传送点 ({})"_trl(localeCode, pager.describe(localeCode)));
     fm.appendButton(
         "模糊搜索"_trl(localeCode),
         "textures/ui/magnifyingGlass",
         "path",
         [rawCB = callback](Player& self) { _sendFuzzySearchGUI(self, rawCB); }
     );
-    for (auto const& warp : warps) {
-        fm.appendButton(warp.name, [warp, cb = callback](Player& self) { cb(self, warp); });
+    fm.appendButton(
+        "附近的传送点"_trl(localeCode),
+        "textures/ui/worldsIcon",
+        "path",
+        [rawCB = callback](Player& self) { _sendNearbyWarpGUI(self, rawCB); }
+    );
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        appendWarpButton(fm, warps[i].name, warps[i].name, callback);
+    }
+    pager.appendButtons(fm, localeCode, [callback](Player& self, std::size_t target) {
+        _sendChooseWarpGUI(self, callback, target);
+    });
+    fm.sendTo(player);
+}
+
+void WarpGUI::_sendSearchResultGUI(Player& player, std::string keyword, ChooseWarpCB callback, std::size_t page) {
+    auto localeCode = player.getLocaleCode();
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    auto matches    = storage->searchWarps(keyword); // 翻页时重新搜索, 不在回调中保存结果
+
+    FormPager pager{matches.size(), page};
+
+    auto fm = BackSimpleForm::make<WarpGUI::sendMainMenu>(nullptr);
+    fm.setTitle("Warp - 搜索结果"_trl(localeCode));
+    fm.setContent("共找到 {} 个传送点 ({})"_trl(localeCode, matches.size(), pager.describe(localeCode)));
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        auto const& name = storage->getSearchIndex().getName(matches[i].id);
+        appendWarpButton(fm, name, name, callback);
     }
+    pager.appendButtons(fm, localeCode, [keyword, callback](Player& self, std::size_t target) {
+        _sendSearchResultGUI(self, keyword, callback, target);
+    });
+    fm.sendTo(player);
+}
+
+void WarpGUI::_sendNearbyWarpGUI(Player& player, ChooseWarpCB callback, std::size_t page) {
+    auto localeCode = player.getLocaleCode();
+    auto storage    = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
+    auto hits       = storage->getNearestWarps(player.getDimensionId(), player.getPosition(), 100);
+
+    FormPager pager{hits.size(), page};
+
+    auto fm = BackSimpleForm::make<WarpGUI::sendMainMenu>(nullptr);
+    fm.setTitle("Warp - 附近的传送点"_trl(localeCode));
+    fm.setContent("当前维度距离最近的 {} 个传送点 ({})"_trl(localeCode, hits.size(), pager.describe(localeCode)));
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        appendWarpButton(fm, hits[i].key, "{}\n{:.1f}m"_trl(localeCode, hits[i].key, hits[i].distance), callback);
+    }
+    pager.appendButtons(fm, localeCode, [callback](Player& self, std::size_t target) {
+        _sendNearbyWarpGUI(self, callback, target);
+    });
     fm.sendTo(player);
 }
 
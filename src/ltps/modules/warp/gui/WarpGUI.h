@@ -2,6 +2,7 @@
 #include "ltps/Global.h"
 #include "ltps/common/BackSimpleForm.h"
 #include "ltps/modules/warp/WarpStorage.h"
+#include <cstddef>
 
 class Player;
 
@@ -19,7 +20,10 @@ class WarpGUI {
     TPSAPI static void sendChooseWarpGUI(Player& player, ChooseWarpCB callback);
     TPSAPI static void sendChooseNameGUI(Player& player, ChooseNameCB callback);
     TPSAPI static void _sendFuzzySearchGUI(Player& player, ChooseWarpCB callback);
-    TPSAPI static void _sendChooseWarpGUI(Player& player, WarpStorage::Warps const& warps, ChooseWarpCB callback);
+    TPSAPI static void _sendChooseWarpGUI(Player& player, ChooseWarpCB callback, std::size_t page = 0);
+    TPSAPI static void
+    _sendSearchResultGUI(Player& player, std::string keyword, ChooseWarpCB callback, std::size_t page = 0);
+    TPSAPI static void _sendNearbyWarpGUI(Player& player, ChooseWarpCB callback, std::size_t page = 0);
 
     TPSAPI static void sendGoWarpGUI(Player& player);
     TPSAPI static void sendAddWarpGUI(Player& player);
@@ -6,9 +6,11 @@
 #include "ltps/Global.h"
 #include "ltps/TeleportSystem.h"
 #include "ltps/common/BackSimpleForm.h"
+#include "ltps/common/FormPager.h"
 #include "ltps/modules/warp/event/WarpEvents.h"
 #include "ltps/utils/McUtils.h"
 #include "mc/world/level/dimension/VanillaDimensions.h"
+#include <cstddef>
 #include <utility>
 
 
@@ -21,7 +23,7 @@ using ll::form::SimpleForm;
 
 void WarpOperatorGUI::sendMainGUI(Player& player) { sendChooseWarpGUI(player, sendOperatorMenu); }
 
-void WarpOperatorGUI::sendChooseWarpGUI(Player& player, ChooseWarpCallback callback) {
+void WarpOperatorGUI::sendChooseWarpGUI(Player& player, ChooseWarpCallback callback, std::size_t page) {
     auto storage = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>();
     if (!storage) {
         return;
@@ -31,33 +33,46 @@ void WarpOperatorGUI::sendChooseWarpGUI(Player& player, ChooseWarpCallback callb
 
     auto& warps = storage->getWarps();
 
+    FormPager pager{warps.size(), page};
+
     auto fm = BackSimpleForm();
     fm.setTitle("Teleport System - Warp Manager"_trl(localeCode));
-    fm.setContent("共有 {} 个传送点, 请选择一个: "_trl(localeCode, warps.size()));
+    fm.setContent("共有 {} 个传送点, 请选择一个 ({}): "_trl(localeCode, warps.size(), pager.describe(localeCode)));
 
     fm.appendButton("创建"_trl(localeCode), "textures/ui/color_plus", "path", [](Player& self) {
         sendCreateOrEditWarpGUI(self);
     });
 
-    for (auto const& warp : warps) {
-        auto _home = warp;
-        fm.appendButton(warp.name, [callback, warp = std::move(_home)](Player& self) { callback(self, warp); });
+    for (auto i = pager.begin(); i < pager.end(); ++i) {
+        // 只保存名称, 点击时再取传送点
+        fm.appendButton(warps[i].name, [callback, name = warps[i].name](Player& self) {
+            auto warp = TeleportSystem::getInstance().getStorageManager().getStorage<WarpStorage>()->getWarp(name);
+            if (!warp) {
+                mc_utils::sendText<mc_utils::Error>(self, "公共传送点 {} 不存在"_trl(self.getLocaleCode(), name));
+                return;
+            }
+            callback(self, std::move(*warp));
+        });
     }
 
+    pager.appendButtons(fm, localeCode, [callback](Player& self, std::size_t target) {
+        sendChooseWarpGUI(self, callback, target);
+    });
+
     fm.sendTo(player);
 }
 
 void WarpOperatorGUI::sendOperatorMenu(Player& player, WarpStorage::Warp warp) {
     auto localeCode = player.getLocaleCode();
 
-    BackSimpleForm::make<sendChooseWarpGUI>(sendOperatorMenu)
+    BackSimpleForm::make<sendChooseWarpGUI>(sendOperatorMenu, std::size_t{0})
         .setTitle("Teleport System - Warp Manager"_trl(localeCode))
         .setContent("名称: {}\n坐标: {}\n创建时间: {}\n修改时间: {}"_trl(
             localeCode,
             warp.name,
             warp.toPosString(),
-            warp.createdTime,
-            warp.modifiedTime
+            warp.getCreatedTimeString(),
+            warp.getModifiedTimeString()
         ))
         .appendButton(
             "前往"_trl(localeCode),
@@ -1,6 +1,7 @@
 #pragma once
 #include "ltps/Global.h"
 #include "ltps/modules/warp/WarpStorage.h"
+#include <cstddef>
 
 class Player;
 
@@ -14,7 +15,7 @@ class WarpOperatorGUI {
     TPSAPI static void sendMainGUI(Player& player);
 
     using ChooseWarpCallback = std::function<void(Player& self, WarpStorage::Warp warp)>;
-    TPSAPI static void sendChooseWarpGUI(Player& player, ChooseWarpCallback callback);
+    TPSAPI static void sendChooseWarpGUI(Player& player, ChooseWarpCallback callback, std::size_t page = 0);
 
     TPSAPI static void sendOperatorMenu(Player& player, WarpStorage::Warp warp);
 
@@ -0,0 +1,158 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+
+namespace ltps::binary_utils {
+
+// 二进制记录头: [Magic][Version], Magic 不会出现在 JSON 文本的首字节, 以此区分旧版 JSON 数据
+inline constexpr std::uint8_t Magic = 0xB1;
+
+inline bool isBinary(std::string_view data) {
+    return !data.empty() && static_cast<std::uint8_t>(data.front()) == Magic;
+}
+
+
+/**
+ * @brief 二进制写入器 (小端序)
+ * 字符串使用 varint 长度前缀
+ */
+class Writer {
+    std::string mBuffer;
+
+public:
+    explicit Writer(std::size_t reserve = 0) { mBuffer.reserve(reserve); }
+
+    Writer& writeHeader(std::uint8_t version) {
+        writeU8(Magic);
+        return writeU8(version);
+    }
+
+    Writer& writeU8(std::uint8_t value) {
+        mBuffer.push_back(static_cast<char>(value));
+        return *this;
+    }
+
+    Writer& writeU32(std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            mBuffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+        return *this;
+    }
+
+    Writer& writeU64(std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            mBuffer.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+        }
+        return *this;
+    }
+
+    Writer& writeI32(std::int32_t value) { return writeU32(static_cast<std::uint32_t>(value)); }
+    Writer& writeI64(std::int64_t value) { return writeU64(static_cast<std::uint64_t>(value)); }
+    Writer& writeF32(float value) { return writeU32(std::bit_cast<std::uint32_t>(value)); }
+
+    Writer& writeVarUInt(std::uint64_t value) {
+        while (value >= 0x80) {
+            mBuffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        mBuffer.push_back(static_cast<char>(value));
+        return *this;
+    }
+
+    Writer& writeBytes(std::string_view value) {
+        mBuffer.append(value);
+        return *this;
+    }
+
+    Writer& writeString(std::string_view value) { return writeVarUInt(value.size()).writeBytes(value); }
+
+    [[nodiscard]] std::size_t size() const { return mBuffer.size(); }
+
+    [[nodiscard]] std::string release() { return std::move(mBuffer); }
+};
+
+
+/**
+ * @brief 二进制读取器，数据不足时抛出 std::runtime_error
+ */
+class Reader {
+    std::string_view mData;
+    std::size_t      mOffset{0};
+
+    void require(std::size_t size) const {
+        if (mData.size() - mOffset < size) {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+    }
+
+public:
+    explicit Reader(std::string_view data) : mData(data) {}
+
+    // 读取并校验记录头，返回版本号
+    std::uint8_t readHeader() {
+        if (readU8() != Magic) {
+            throw std::runtime_error("Invalid binary data header");
+        }
+        return readU8();
+    }
+
+    std::uint8_t readU8() {
+        require(1);
+        return static_cast<std::uint8_t>(mData[mOffset++]);
+    }
+
+    std::uint32_t readU32() {
+        require(4);
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(mData[mOffset++])) << (i * 8);
+        }
+        return value;
+    }
+
+    std::uint64_t readU64() {
+        require(8);
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(mData[mOffset++])) << (i * 8);
+        }
+        return value;
+    }
+
+    std::int32_t readI32() { return static_cast<std::int32_t>(readU32()); }
+    std::int64_t readI64() { return static_cast<std::int64_t>(readU64()); }
+    float        readF32() { return std::bit_cast<float>(readU32()); }
+
+    std::uint64_t readVarUInt() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte  = readU8();
+            value     |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Invalid varint in binary data");
+    }
+
+    std::string_view readBytes(std::size_t size) {
+        require(size);
+        auto view  = mData.substr(mOffset, size);
+        mOffset   += size;
+        return view;
+    }
+
+    std::string_view readStringView() { return readBytes(readVarUInt()); }
+
+    std::string readString() { return std::string{readStringView()}; }
+
+    [[nodiscard]] bool eof() const { return mOffset >= mData.size(); }
+};
+
+
+} // namespace ltps::binary_utils
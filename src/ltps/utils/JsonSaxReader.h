@@ -0,0 +1,162 @@
+#pragma once
+#include "ltps/utils/TimeUtils.h"
+#include "nlohmann/json.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace ltps::json_utils {
+
+/**
+ * @brief 流式 (SAX) 读取 JSON 记录数组，不构建 nlohmann::json DOM
+ * 支持两种布局:
+ *  - Array:          [ {record}, ... ]
+ *  - ObjectOfArrays: { "owner": [ {record}, ... ], ... }  (旧版单键数据)
+ *
+ * 每个 record 的标量字段通过 assign 回调写入，未知字段与嵌套的对象/数组会被忽略，缺失的字段保留默认值。
+ * 每读完一个数组即调用一次 callback，峰值内存只与单个数组的记录数相关。
+ */
+template <typename T>
+class RecordSaxReader final : public nlohmann::json_sax<nlohmann::json> {
+public:
+    enum class Layout { Array, ObjectOfArrays };
+
+    using Value    = std::variant<std::monostate, bool, std::int64_t, double, std::string>;
+    using Assign   = std::function<void(T& record, std::string_view field, Value const& value)>;
+    using Callback = std::function<void(std::string_view owner, std::vector<T> records)>;
+
+private:
+    Layout         mLayout;
+    Assign         mAssign;
+    Callback       mCallback;
+    std::size_t    mDepth{0};
+    bool           mInRecord{false};
+    std::string    mOwner;
+    std::string    mField;
+    std::vector<T> mRecords;
+    std::string    mError;
+
+    [[nodiscard]] std::size_t arrayDepth() const { return mLayout == Layout::Array ? 1 : 2; }
+    [[nodiscard]] std::size_t recordDepth() const { return arrayDepth() + 1; }
+
+    bool onValue(Value value) {
+        if (mInRecord && mDepth == recordDepth()) {
+            mAssign(mRecords.back(), mField, value);
+        }
+        return true;
+    }
+
+public:
+    RecordSaxReader(Layout layout, Assign assign, Callback callback)
+    : mLayout(layout),
+      mAssign(std::move(assign)),
+      mCallback(std::move(callback)) {}
+
+    // 解析失败时抛出 std::runtime_error
+    void parse(std::string_view data) {
+        if (!nlohmann::json::sax_parse(data, this)) {
+            throw std::runtime_error(mError.empty() ? "Unexpected JSON layout" : mError);
+        }
+    }
+
+    bool null() override { return onValue(std::monostate{}); }
+    bool boolean(bool val) override { return onValue(val); }
+    bool number_integer(number_integer_t val) override { return onValue(static_cast<std::int64_t>(val)); }
+    bool number_unsigned(number_unsigned_t val) override { return onValue(static_cast<std::int64_t>(val)); }
+    bool number_float(number_float_t val, string_t const&) override { return onValue(static_cast<double>(val)); }
+    bool string(string_t& val) override { return onValue(std::move(val)); }
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        ++mDepth;
+        if (mDepth == 1 && mLayout == Layout::Array) {
+            mError = "Expected a JSON array";
+            return false;
+        }
+        if (mDepth == recordDepth()) {
+            mRecords.emplace_back();
+            mInRecord = true;
+        }
+        return true;
+    }
+
+    bool end_object() override {
+        if (mDepth == recordDepth()) {
+            mInRecord = false;
+        }
+        --mDepth;
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (mDepth == 1 && mLayout == Layout::ObjectOfArrays) {
+            mOwner = std::move(val);
+        } else if (mDepth == recordDepth()) {
+            mField = std::move(val);
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        ++mDepth;
+        if (mDepth == 1 && mLayout == Layout::ObjectOfArrays) {
+            mError = "Expected a JSON object";
+            return false;
+        }
+        if (mDepth == arrayDepth()) {
+            mRecords.clear();
+        }
+        return true;
+    }
+
+    bool end_array() override {
+        if (mDepth == arrayDepth()) {
+            mCallback(mOwner, std::move(mRecords));
+            mRecords = {};
+        }
+        --mDepth;
+        return true;
+    }
+
+    bool parse_error(std::size_t, std::string const&, nlohmann::detail::exception const& ex) override {
+        mError = ex.what();
+        return false;
+    }
+};
+
+// 将数值字段转换为目标类型, 类型不匹配时保持原值
+template <typename N, typename V>
+inline void assignNumber(N& target, V const& value) {
+    if (auto i = std::get_if<std::int64_t>(&value)) {
+        target = static_cast<N>(*i);
+    } else if (auto d = std::get_if<double>(&value)) {
+        target = static_cast<N>(*d);
+    }
+}
+
+template <typename V>
+inline void assignString(std::string& target, V const& value) {
+    if (auto s = std::get_if<std::string>(&value)) {
+        target = *s;
+    }
+}
+
+// 时间字段: 数值为 Unix 时间戳, 字符串为旧版 yyyy-MM-dd HH:mm:ss 格式
+template <typename V>
+inline void assignEpoch(std::int64_t& target, V const& value) {
+    if (auto s = std::get_if<std::string>(&value)) {
+        target = time_utils::parseEpoch(*s);
+    } else {
+        assignNumber(target, value);
+    }
+}
+
+
+} // namespace ltps::json_utils
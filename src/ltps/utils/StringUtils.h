@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <ranges>
 #include <string>
+#include <string_view>
 
 
 namespace string_utils {
@@ -32,4 +33,34 @@ inline std::string snake_to_pascal(std::string_view snake_str) {
     return result;
 }
 
+// 解码 UTF-8 为码点序列并将 ASCII 字母转为小写 (用于不区分大小写的匹配), 非法序列按 U+FFFD 处理
+inline std::u32string decodeUtf8Folded(std::string_view str) {
+    std::u32string result;
+    result.reserve(str.size());
+    std::size_t i = 0;
+    while (i < str.size()) {
+        auto        lead  = static_cast<unsigned char>(str[i++]);
+        std::size_t extra = 0;
+        char32_t    cp    = 0;
+        if (lead < 0x80) {
+            result.push_back(lead >= 'A' && lead <= 'Z' ? lead + ('a' - 'A') : lead);
+            continue;
+        } else if ((lead & 0xE0) == 0xC0) {
+            extra = 1, cp = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            extra = 2, cp = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            extra = 3, cp = lead & 0x07;
+        } else {
+            result.push_back(U'\uFFFD');
+            continue;
+        }
+        for (; extra > 0 && i < str.size() && (static_cast<unsigned char>(str[i]) & 0xC0) == 0x80; --extra) {
+            cp = (cp << 6) | (static_cast<unsigned char>(str[i++]) & 0x3F);
+        }
+        result.push_back(extra == 0 ? cp : U'\uFFFD');
+    }
+    return result;
+}
+
 } // namespace string_utils
\ No newline at end of file
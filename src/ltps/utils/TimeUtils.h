@@ -1,8 +1,11 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <ctime>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
+#include <iomanip>
 #include <iostream>
 #include <optional>
 #include <sstream>
@@ -44,6 +47,22 @@ inline std::optional<TimePoint> parseTimeString(const std::string& timeStr) {
     return Clock::from_time_t(std::mktime(&tm));
 }
 
+// 获取当前 Unix 时间戳 (秒)
+inline std::int64_t getCurrentEpoch() {
+    return std::chrono::duration_cast<std::chrono::seconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Unix 时间戳 (秒) 转本地时间字符串 yyyy-MM-dd HH:mm:ss
+inline std::string epochToString(std::int64_t epoch) {
+    return timeToString(Clock::from_time_t(static_cast<std::time_t>(epoch)));
+}
+
+// 字符串 (yyyy-MM-dd HH:mm:ss) 转 Unix 时间戳 (秒)，解析失败时返回 0
+inline std::int64_t parseEpoch(const std::string& timeStr) {
+    auto tp = parseTimeString(timeStr);
+    return tp ? std::chrono::duration_cast<std::chrono::seconds>(tp->time_since_epoch()).count() : 0;
+}
+
 // 获取将来时间点
 inline TimePoint futureTime(int seconds) { return Clock::now() + std::chrono::seconds(seconds); }
 
@@ -0,0 +1,170 @@
+#include "TestUtils.h"
+#include "ltps/common/BatchQueue.h"
+#include "ltps/utils/TimeUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ltps::test {
+
+
+// 模拟服务器线程的任务队列: 生产者投递任务, 消费者线程依次执行
+struct SimulatedExecutor {
+    std::mutex                        mMutex;
+    std::deque<std::function<void()>> mTasks;
+    std::size_t                       mExecuted{0};
+
+    void execute(std::function<void()> task) {
+        std::lock_guard lock{mMutex};
+        mTasks.push_back(std::move(task));
+    }
+
+    bool runOne() {
+        std::function<void()> task;
+        {
+            std::lock_guard lock{mMutex};
+            if (mTasks.empty()) {
+                return false;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+        task();
+        ++mExecuted;
+        return true;
+    }
+};
+
+void BatchQueueTest() {
+    // 只有开启新批次的 push 返回 true, drain 按投递顺序取走全部元素并开启下一批次
+    BatchQueue<int>  queue;
+    std::vector<int> batch{-1};
+    TPS_EXPECT(queue.push(1));
+    TPS_EXPECT(!queue.push(2) && !queue.push(3) && queue.size() == 3);
+    queue.drain(batch);
+    TPS_EXPECT((batch == std::vector<int>{1, 2, 3}) && queue.size() == 0);
+    TPS_EXPECT(queue.push(4));
+    queue.drain(batch);
+    TPS_EXPECT((batch == std::vector<int>{4}));
+
+    // 空批次: drain 清空调用方缓冲区, 之后的 push 仍开启新批次
+    queue.drain(batch);
+    TPS_EXPECT(batch.empty() && queue.push(5));
+
+    // 多个生产者并发投递: 每个元素恰好交付一次, 且每个批次只派发一次消费任务
+    constexpr std::size_t    producers = 4, items = 4'000;
+    SimulatedExecutor        executor;
+    BatchQueue<std::size_t>  concurrent;
+    std::vector<std::size_t> drained, delivered(items, 0);
+    std::size_t              emptyBatches = 0; // 每次派发至少应对应一个元素
+    std::atomic<std::size_t> handled{0};
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (std::size_t i = p; i < items; i += producers) {
+                if (concurrent.push(i)) {
+                    executor.execute([&] {
+                        concurrent.drain(drained);
+                        emptyBatches += drained.empty();
+                        for (auto item : drained) {
+                            ++delivered[item];
+                        }
+                        handled += drained.size();
+                    });
+                }
+            }
+        });
+    }
+    while (handled.load() < items) {
+        if (!executor.runOne()) {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    TPS_EXPECT(!executor.runOne() && concurrent.size() == 0 && emptyBatches == 0);
+    TPS_EXPECT(std::all_of(delivered.begin(), delivered.end(), [](std::size_t count) { return count == 1; }));
+    TPS_EXPECT(executor.mExecuted <= items);
+}
+
+
+#ifdef TPS_BENCHMARK
+// producers 个线程共投递 items 个过期请求, 对比每个请求一个任务与按批次一个任务
+static void benchmarkBatchQueue(std::size_t producers, std::size_t items) {
+    using Request = std::shared_ptr<std::size_t>;
+
+    auto run = [&](auto&& submit, std::atomic<std::size_t>& handled) {
+        SimulatedExecutor        executor;
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::size_t i = p; i < items; i += producers) {
+                    submit(executor, std::make_shared<std::size_t>(i));
+                }
+            });
+        }
+        while (handled.load() < items) {
+            if (!executor.runOne()) {
+                std::this_thread::yield();
+            }
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return executor.mExecuted;
+    };
+
+    std::atomic<std::size_t> perItemHandled{0};
+    std::size_t              perItemTasks = 0;
+    {
+        time_utils::Timer timer{"per-request tasks x" + std::to_string(items)};
+        perItemTasks = run(
+            [&](SimulatedExecutor& executor, Request request) {
+                executor.execute([&, request] { perItemHandled += request != nullptr; });
+            },
+            perItemHandled
+        );
+    }
+
+    BatchQueue<Request>      queue;
+    std::vector<Request>     batch;
+    std::size_t              maxBatch = 0;
+    std::atomic<std::size_t> batchedHandled{0};
+    std::size_t              batchedTasks = 0;
+    {
+        time_utils::Timer timer{"batched tasks x" + std::to_string(items)};
+        batchedTasks = run(
+            [&](SimulatedExecutor& executor, Request request) {
+                if (queue.push(std::move(request))) {
+                    executor.execute([&] {
+                        queue.drain(batch);
+                        maxBatch        = std::max(maxBatch, batch.size());
+                        batchedHandled += batch.size();
+                    });
+                }
+            },
+            batchedHandled
+        );
+    }
+
+    TPS_EXPECT(perItemTasks == items && batchedHandled.load() == items && batchedTasks <= items);
+    TPS_EXPECT(queue.size() == 0);
+    std::cout << "batch queue items: " << items << ", per-request tasks: " << perItemTasks
+              << ", batched tasks: " << batchedTasks << ", max batch: " << maxBatch << std::endl;
+}
+
+
+void BatchQueueBenchmark() { benchmarkBatchQueue(4, 1'000'000); }
+#endif
+
+
+} // namespace ltps::test
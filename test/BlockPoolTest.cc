@@ -0,0 +1,114 @@
+#include "TestUtils.h"
+#include "ltps/common/BlockPool.h"
+#include "ltps/utils/TimeUtils.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace ltps::test {
+
+
+// 与 TpaRequest::Impl 大小相近: 两个弱引用、两个 UUID、类型与状态、两个时间点
+struct PooledRequest : std::enable_shared_from_this<PooledRequest> {
+    std::array<std::uint64_t, 4>          refs{};
+    std::array<std::uint64_t, 4>          uuids{};
+    int                                   type{0};
+    int                                   state{0};
+    std::chrono::system_clock::time_point created{};
+    std::chrono::steady_clock::time_point expire{};
+
+    explicit PooledRequest(int type) : type(type) {}
+};
+
+void BlockPoolTest() {
+    // 释放的块放回空闲列表并被下一次分配复用
+    BlockPool pool{2};
+    auto*     first = pool.allocate(64);
+    pool.deallocate(first, 64);
+    TPS_EXPECT(pool.allocate(64) == first);
+    auto stats = pool.getStats();
+    TPS_EXPECT(stats.allocations == 2 && stats.reused == 1 && stats.heapAllocations == 1);
+    TPS_EXPECT(stats.inUse == 1 && stats.free == 0);
+
+    // 大小不符的请求直接转交全局 operator new, 不计入借出块数
+    auto* other = pool.allocate(128);
+    TPS_EXPECT(pool.getStats().heapAllocations == 2 && pool.getStats().inUse == 1);
+    pool.deallocate(other, 128);
+    TPS_EXPECT(pool.getStats().free == 0);
+
+    // 空闲块不超过 maxFree, 多余的块真正释放
+    auto* second = pool.allocate(64);
+    auto* third  = pool.allocate(64);
+    pool.deallocate(first, 64);
+    pool.deallocate(second, 64);
+    pool.deallocate(third, 64);
+    stats = pool.getStats();
+    TPS_EXPECT(stats.inUse == 0 && stats.free == 2);
+
+    // allocate_shared: 对象与控制块共用一个块, 销毁后归还; 数组分配退回 std::allocator
+    auto& shared = BlockPool::of<PooledRequest>();
+    auto  before = shared.getStats();
+    {
+        auto request = std::allocate_shared<PooledRequest>(PoolAllocator<PooledRequest>{}, 7);
+        TPS_EXPECT(request->type == 7 && request->shared_from_this() == request);
+        TPS_EXPECT(shared.getStats().inUse == before.inUse + 1);
+    }
+    TPS_EXPECT(shared.getStats().inUse == before.inUse && shared.getStats().free == before.free + 1);
+
+    PoolAllocator<PooledRequest> allocator;
+    auto*                        array = allocator.allocate(2);
+    allocator.deallocate(array, 2);
+    TPS_EXPECT(shared.getStats().allocations == before.allocations + 1);
+}
+
+
+#ifdef TPS_BENCHMARK
+// 保持 live 个请求存活, 每一步创建一个新请求并释放最早的请求, 对比 make_shared 与池化 allocate_shared
+static void benchmarkBlockPool(std::size_t live, std::size_t steps) {
+    auto churn = [&](auto&& create) {
+        std::deque<std::shared_ptr<PooledRequest>> requests;
+        for (std::size_t i = 0; i < steps; ++i) {
+            requests.push_back(create(static_cast<int>(i)));
+            if (requests.size() > live) {
+                requests.pop_front();
+            }
+        }
+    };
+
+    {
+        time_utils::Timer timer{"make_shared churn " + std::to_string(steps)};
+        churn([](int type) { return std::make_shared<PooledRequest>(type); });
+    }
+
+    auto& pool   = BlockPool::of<PooledRequest>();
+    auto  create = [](int type) {
+        return std::allocate_shared<PooledRequest>(PoolAllocator<PooledRequest>{}, type);
+    };
+    churn(create); // 预热: 空闲列表补足到 live 个块
+
+    auto before = pool.getStats();
+    {
+        time_utils::Timer timer{"pooled churn " + std::to_string(steps)};
+        churn(create);
+    }
+    auto after = pool.getStats();
+
+    // 稳定状态下所有分配都应复用空闲块
+    auto heap   = after.heapAllocations - before.heapAllocations;
+    auto reused = after.reused - before.reused;
+    TPS_EXPECT(heap == 0 && reused == after.allocations - before.allocations && after.inUse == 0);
+    std::cout << "block pool steps: " << steps << ", live: " << live << ", heap allocations: " << heap
+              << ", reused: " << reused << ", free blocks: " << after.free << std::endl;
+}
+
+
+void BlockPoolBenchmark() { benchmarkBlockPool(2'000, 1'000'000); }
+#endif
+
+
+} // namespace ltps::test
@@ -0,0 +1,176 @@
+#include "TestUtils.h"
+#include "ltps/common/CoordinateColumns.h"
+#include "ltps/utils/TimeUtils.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ltps::test {
+
+
+// 与 Warp / Home 相同的数组结构体布局: 坐标与维度之后是时间与名称
+struct AosRecord {
+    float        x, y, z;
+    int          dimid;
+    std::int64_t createdTime;
+    std::int64_t modifiedTime;
+    std::string  name;
+};
+
+void CoordinateColumnsTest() {
+    // 7 个点: 前 4 个走批量路径, 后 3 个走尾部的标量路径
+    CoordinateColumns columns;
+    columns.push_back(0, 0.0f, 0.0f, 0.0f);  // 0
+    columns.push_back(0, 3.0f, 4.0f, 0.0f);  // 1: 距原点 5
+    columns.push_back(1, 1.0f, 0.0f, 0.0f);  // 2: 其它维度
+    columns.push_back(0, -1.0f, 0.0f, 0.0f); // 3
+    columns.push_back(0, 0.0f, 0.0f, 5.0f);  // 4: 距原点 5, 位于尾部
+    columns.push_back(0, 0.0f, 6.0f, 0.0f);  // 5
+    columns.push_back(1, 0.0f, 0.0f, 0.0f);  // 6: 其它维度
+
+    std::vector<float> distances(columns.size());
+    columns.distanceSquared(0, 0.0f, 0.0f, 0.0f, distances);
+    TPS_EXPECT(distances[0] == 0.0f && distances[1] == 25.0f && distances[4] == 25.0f && distances[5] == 36.0f);
+    TPS_EXPECT(distances[2] == std::numeric_limits<float>::infinity());
+    TPS_EXPECT(distances[6] == std::numeric_limits<float>::infinity());
+
+    // 半径与包围盒均包含边界, 结果为升序下标
+    std::vector<std::uint32_t> indices;
+    columns.withinRadius(0, 0.0f, 0.0f, 0.0f, 5.0f, indices);
+    TPS_EXPECT((indices == std::vector<std::uint32_t>{0, 1, 3, 4}));
+    indices.clear();
+    columns.withinBox(0, -1.0f, 0.0f, 0.0f, 3.0f, 4.0f, 0.0f, indices);
+    TPS_EXPECT((indices == std::vector<std::uint32_t>{0, 1, 3}));
+    indices.clear();
+    columns.withinBox(1, -10.0f, -10.0f, -10.0f, 10.0f, 10.0f, 10.0f, indices);
+    TPS_EXPECT((indices == std::vector<std::uint32_t>{2, 6}));
+
+    auto hits = columns.nearest(0, 0.0f, 0.0f, 0.0f, 3);
+    TPS_EXPECT(hits.size() == 3 && hits[0].index == 0 && hits[1].index == 3 && hits[2].distance == 5.0f);
+    TPS_EXPECT(columns.nearest(0, 0.0f, 0.0f, 0.0f, 10, 4.0f).size() == 2);
+    TPS_EXPECT(columns.nearest(2, 0.0f, 0.0f, 0.0f, 10).empty());
+
+    // erase 保持顺序, set 可修改维度
+    columns.erase(0);
+    TPS_EXPECT(columns.size() == 6 && columns.x(0) == 3.0f && columns.dimid(1) == 1);
+    columns.set(1, 0, 100.0f, 0.0f, 0.0f);
+    indices.clear();
+    columns.withinRadius(0, 100.0f, 0.0f, 0.0f, 1.0f, indices);
+    TPS_EXPECT((indices == std::vector<std::uint32_t>{1}));
+    indices.clear();
+    columns.withinRadius(1, 0.0f, 0.0f, 0.0f, 1'000.0f, indices);
+    TPS_EXPECT((indices == std::vector<std::uint32_t>{5}));
+}
+
+
+#ifdef TPS_BENCHMARK
+// count 条随机记录, 分别以结构体数组与列存执行 queries 次距离计算、半径与包围盒筛选, 对比结果与耗时
+static void benchmarkCoordinateColumns(std::size_t count, std::size_t queries) {
+    std::mt19937                          rng{42};
+    std::uniform_real_distribution<float> horizontal{-5'000.0f, 5'000.0f}, vertical{-64.0f, 320.0f};
+
+    std::vector<AosRecord> records;
+    CoordinateColumns      columns;
+    records.reserve(count);
+    columns.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        AosRecord record{horizontal(rng), vertical(rng), horizontal(rng), static_cast<int>(i % 3), 0, 0, {}};
+        record.name = "warp_" + std::to_string(i);
+        columns.push_back(record.dimid, record.x, record.y, record.z);
+        records.push_back(std::move(record));
+    }
+
+    struct Probe {
+        int   dimid;
+        float x, y, z;
+    };
+    std::vector<Probe> probes;
+    for (std::size_t i = 0; i < queries; ++i) {
+        probes.push_back({static_cast<int>(i % 3), horizontal(rng), vertical(rng), horizontal(rng)});
+    }
+    constexpr float radius = 500.0f;
+
+    std::size_t        aosRadius = 0, soaRadius = 0, aosBox = 0, soaBox = 0;
+    std::vector<float> aosDistances(count), soaDistances(count);
+    {
+        time_utils::Timer timer{"AoS distance x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto dx = records[i].x - p.x, dy = records[i].y - p.y, dz = records[i].z - p.z;
+                aosDistances[i] = records[i].dimid == p.dimid ? dx * dx + dy * dy + dz * dz
+                                                              : std::numeric_limits<float>::infinity();
+            }
+        }
+    }
+    {
+        time_utils::Timer timer{"SoA distance x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            columns.distanceSquared(p.dimid, p.x, p.y, p.z, soaDistances);
+        }
+    }
+    bool sameDistances = aosDistances == soaDistances; // 最后一次查询的结果
+
+    std::vector<std::uint32_t> indices;
+    {
+        time_utils::Timer timer{"AoS radius x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            for (auto const& r : records) {
+                auto dx = r.x - p.x, dy = r.y - p.y, dz = r.z - p.z;
+                if (r.dimid == p.dimid && dx * dx + dy * dy + dz * dz <= radius * radius) {
+                    ++aosRadius;
+                }
+            }
+        }
+    }
+    {
+        time_utils::Timer timer{"SoA radius x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            indices.clear();
+            columns.withinRadius(p.dimid, p.x, p.y, p.z, radius, indices);
+            soaRadius += indices.size();
+        }
+    }
+
+    {
+        time_utils::Timer timer{"AoS box x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            for (auto const& r : records) {
+                if (r.dimid == p.dimid && r.x >= p.x - radius && r.x <= p.x + radius && r.y >= p.y - radius
+                    && r.y <= p.y + radius && r.z >= p.z - radius && r.z <= p.z + radius) {
+                    ++aosBox;
+                }
+            }
+        }
+    }
+    {
+        time_utils::Timer timer{"SoA box x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            indices.clear();
+            columns.withinBox(
+                p.dimid,
+                p.x - radius,
+                p.y - radius,
+                p.z - radius,
+                p.x + radius,
+                p.y + radius,
+                p.z + radius,
+                indices
+            );
+            soaBox += indices.size();
+        }
+    }
+
+    TPS_EXPECT(sameDistances && aosRadius == soaRadius && aosBox == soaBox);
+    std::cout << "coordinate columns records: " << count << ", queries: " << queries << std::endl;
+}
+
+
+void CoordinateColumnsBenchmark() { benchmarkCoordinateColumns(100'000, 200); }
+#endif
+
+
+} // namespace ltps::test
@@ -0,0 +1,249 @@
+#include "TestUtils.h"
+#include "ltps/common/PairIndex.h"
+#include "ltps/utils/TimeUtils.h"
+#include "mc/platform/UUID.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ltps::test {
+
+
+// 所有 ID 哈希相同, 有序对与按 ID 的链表头都落在同一条探测链上
+struct CollidingHash {
+    std::size_t operator()(int) const { return 7; }
+};
+
+template <typename Index>
+static std::vector<int> secondsOf(Index const& index, int first) {
+    std::vector<int> result;
+    index.forEachByFirst(first, [&](int second, auto const&) { result.push_back(second); });
+    return result;
+}
+
+void PairIndexTest() {
+    // 有序对区分方向, 重复插入保留原值
+    PairIndex<int, int> index;
+    TPS_EXPECT(index.try_emplace(1, 2, 12).second);
+    TPS_EXPECT(!index.try_emplace(1, 2, 99).second && *index.find(1, 2) == 12);
+    TPS_EXPECT(!index.contains(2, 1));
+    TPS_EXPECT(index.try_emplace(1, 3, 13).second && index.try_emplace(4, 1, 41).second);
+    TPS_EXPECT((secondsOf(index, 1) == std::vector<int>{3, 2})); // 插入顺序的逆序
+
+    // 删除后重新插入: 复用节点, 新值生效, 两条链表同步更新
+    TPS_EXPECT(index.extract(1, 2) == 12);
+    TPS_EXPECT(!index.contains(1, 2) && !index.erase(1, 2) && !index.extract(1, 2));
+    TPS_EXPECT((secondsOf(index, 1) == std::vector<int>{3}));
+    TPS_EXPECT(index.try_emplace(1, 2, 120).second && *index.find(1, 2) == 120);
+    TPS_EXPECT((secondsOf(index, 1) == std::vector<int>{2, 3}));
+    std::size_t bySecond = 0;
+    index.forEachBySecond(2, [&](int first, int value) { bySecond += first == 1 && value == 120; });
+    TPS_EXPECT(bySecond == 1 && index.size() == 3);
+
+    // 按 ID 移除同时清理作为 first 与 second 的条目, 其余 ID 的链表不受影响
+    std::vector<int> removed;
+    TPS_EXPECT(index.eraseById(1, [&](auto const&, int value) { removed.push_back(value); }) == 3);
+    std::sort(removed.begin(), removed.end());
+    TPS_EXPECT((removed == std::vector<int>{13, 41, 120}));
+    TPS_EXPECT(index.empty() && secondsOf(index, 4).empty());
+
+    // 值在移除时立即释放
+    PairIndex<int, std::shared_ptr<int>> owners;
+    auto                                 value = std::make_shared<int>(1);
+    owners.try_emplace(1, 2, value);
+    TPS_EXPECT(value.use_count() == 2 && owners.erase(1, 2) && value.use_count() == 1);
+
+    // 哈希冲突: 所有条目在同一探测链上, 隔一个删除再重新插入后仍全部可查
+    PairIndex<int, int, CollidingHash> chain;
+    for (int i = 0; i < 64; ++i) {
+        TPS_EXPECT(chain.try_emplace(i % 8, i, i * 10).second);
+    }
+    for (int i = 0; i < 64; i += 2) {
+        TPS_EXPECT(chain.erase(i % 8, i));
+    }
+    for (int i = 0; i < 64; ++i) {
+        auto found = chain.find(i % 8, i);
+        TPS_EXPECT((i % 2 == 0) == (found == nullptr));
+        TPS_EXPECT(!found || *found == i * 10);
+    }
+    for (int i = 0; i < 64; i += 2) {
+        TPS_EXPECT(chain.try_emplace(i % 8, i, i * 100).second);
+    }
+    for (int i = 0; i < 64; ++i) {
+        TPS_EXPECT(*chain.find(i % 8, i) == (i % 2 == 0 ? i * 100 : i * 10));
+    }
+    TPS_EXPECT(chain.size() == 64 && secondsOf(chain, 3).size() == 8);
+    for (int first = 0; first < 8; ++first) {
+        TPS_EXPECT(chain.eraseById(first, [](auto const&, int) {}) == 8);
+    }
+    TPS_EXPECT(chain.empty() && !chain.contains(3, 3));
+}
+
+
+#ifdef TPS_BENCHMARK
+// 与 TpaRequestPool 原先的结构一致: Receiver -> [Sender] -> Request 与 Sender -> [Receiver] -> Request
+struct NestedRequestMaps {
+    using Request = std::shared_ptr<std::size_t>;
+    using Map     = std::unordered_map<mce::UUID, std::unordered_map<mce::UUID, Request>>;
+
+    Map mForward;
+    Map mReverse;
+
+    void add(mce::UUID const& sender, mce::UUID const& receiver, Request const& request) {
+        mForward[receiver][sender] = request;
+        mReverse[sender][receiver] = request;
+    }
+
+    Request find(mce::UUID const& sender, mce::UUID const& receiver) const {
+        if (auto iter = mForward.find(receiver); iter != mForward.end()) {
+            if (auto iter2 = iter->second.find(sender); iter2 != iter->second.end()) {
+                return iter2->second;
+            }
+        }
+        return nullptr;
+    }
+
+    static void eraseFrom(Map& map, mce::UUID const& outer, mce::UUID const& inner) {
+        if (auto iter = map.find(outer); iter != map.end()) {
+            iter->second.erase(inner);
+            if (iter->second.empty()) {
+                map.erase(iter);
+            }
+        }
+    }
+
+    void remove(mce::UUID const& sender, mce::UUID const& receiver) {
+        eraseFrom(mForward, receiver, sender);
+        eraseFrom(mReverse, sender, receiver);
+    }
+
+    std::size_t disconnect(mce::UUID const& player) {
+        std::size_t count = 0;
+        if (auto iter = mForward.find(player); iter != mForward.end()) {
+            for (auto& [sender, _] : iter->second) {
+                eraseFrom(mReverse, sender, player);
+                ++count;
+            }
+            mForward.erase(iter);
+        }
+        if (auto iter = mReverse.find(player); iter != mReverse.end()) {
+            for (auto& [receiver, _] : iter->second) {
+                eraseFrom(mForward, receiver, player);
+                ++count;
+            }
+            mReverse.erase(iter);
+        }
+        return count;
+    }
+};
+
+// players 名玩家之间 requests 个待处理请求, 对比创建 / 查找 / 移除一半 / 全部玩家离线的耗时与结果
+static void benchmarkPairIndex(std::size_t players, std::size_t requests) {
+    using Request = std::shared_ptr<std::size_t>;
+
+    std::mt19937_64        rng{42};
+    std::vector<mce::UUID> uuids;
+    for (std::size_t i = 0; i < players; ++i) {
+        uuids.emplace_back(rng(), rng());
+    }
+    std::uniform_int_distribution<std::size_t> pick{0, players - 1};
+
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    {
+        PairIndex<std::size_t, bool> unique;
+        while (pairs.size() < requests) {
+            auto sender = pick(rng), receiver = pick(rng);
+            if (sender != receiver && unique.try_emplace(sender, receiver, true).second) {
+                pairs.emplace_back(sender, receiver);
+            }
+        }
+    }
+
+    auto label = [&](char const* name) { return std::string{name} + " x" + std::to_string(requests); };
+
+    NestedRequestMaps nested;
+    std::size_t       nestedFound = 0, nestedDisconnected = 0;
+    {
+        time_utils::Timer timer{label("nested maps create")};
+        for (std::size_t i = 0; i < pairs.size(); ++i) {
+            nested.add(uuids[pairs[i].first], uuids[pairs[i].second], std::make_shared<std::size_t>(i));
+        }
+    }
+    {
+        time_utils::Timer timer{label("nested maps lookup")};
+        for (auto& [sender, receiver] : pairs) {
+            nestedFound += nested.find(uuids[sender], uuids[receiver]) != nullptr;
+            nestedFound += nested.find(uuids[receiver], uuids[sender]) != nullptr; // 大多不存在
+        }
+    }
+    {
+        time_utils::Timer timer{label("nested maps remove half")};
+        for (std::size_t i = 0; i < pairs.size(); i += 2) {
+            nested.remove(uuids[pairs[i].first], uuids[pairs[i].second]);
+        }
+    }
+    {
+        time_utils::Timer timer{label("nested maps disconnect all")};
+        for (auto const& uuid : uuids) {
+            nestedDisconnected += nested.disconnect(uuid);
+        }
+    }
+    bool nestedEmpty = nested.mForward.empty() && nested.mReverse.empty();
+
+    PairIndex<mce::UUID, Request> index;
+    std::size_t                   indexFound = 0, indexDisconnected = 0;
+    {
+        time_utils::Timer timer{label("pair index create")};
+        for (std::size_t i = 0; i < pairs.size(); ++i) {
+            index.try_emplace(uuids[pairs[i].first], uuids[pairs[i].second], std::make_shared<std::size_t>(i));
+        }
+    }
+    {
+        time_utils::Timer timer{label("pair index lookup")};
+        for (auto& [sender, receiver] : pairs) {
+            indexFound += index.contains(uuids[sender], uuids[receiver]);
+            indexFound += index.contains(uuids[receiver], uuids[sender]);
+        }
+    }
+    {
+        time_utils::Timer timer{label("pair index remove half")};
+        for (std::size_t i = 0; i < pairs.size(); i += 2) {
+            index.erase(uuids[pairs[i].first], uuids[pairs[i].second]);
+        }
+    }
+
+    // 离线前核对按发起者 / 接收者遍历的结果与剩余条目一致
+    std::size_t byFirst = 0, bySecond = 0;
+    for (auto const& uuid : uuids) {
+        index.forEachByFirst(uuid, [&](mce::UUID const&, Request const&) { ++byFirst; });
+        index.forEachBySecond(uuid, [&](mce::UUID const&, Request const&) { ++bySecond; });
+    }
+    bool sameLists = byFirst == index.size() && bySecond == index.size();
+
+    {
+        time_utils::Timer timer{label("pair index disconnect all")};
+        for (auto const& uuid : uuids) {
+            indexDisconnected += index.eraseById(uuid, [](auto const&, Request&&) {});
+        }
+    }
+
+    TPS_EXPECT(nestedEmpty && sameLists && index.empty());
+    TPS_EXPECT(nestedFound == indexFound && nestedDisconnected == indexDisconnected);
+    TPS_EXPECT(indexDisconnected == requests / 2);
+    std::cout << "pair index players: " << players << ", requests: " << requests << ", found: " << indexFound
+              << ", disconnected: " << indexDisconnected << std::endl;
+}
+
+
+void PairIndexBenchmark() { benchmarkPairIndex(10'000, 100'000); }
+#endif
+
+
+} // namespace ltps::test
@@ -0,0 +1,178 @@
+#include "TestUtils.h"
+#include "ltps/modules/home/HomeStorage.h"
+#include "ltps/utils/BinaryUtils.h"
+#include "ltps/utils/JsonUtls.h"
+#include "ltps/utils/TimeUtils.h"
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ltps::test {
+
+using home::HomeStorage;
+
+
+static HomeStorage::Homes makeHomes(std::size_t count) {
+    HomeStorage::Homes homes;
+    homes.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        HomeStorage::Home home{};
+        home.x            = static_cast<float>(i) * 1.5f;
+        home.y            = 64.0f;
+        home.z            = static_cast<float>(i) * -2.25f;
+        home.dimid        = static_cast<int>(i % 3);
+        home.name         = "home_" + std::to_string(i);
+        home.createdTime  = 1735732800; // 2025-01-01 12:00:00 UTC
+        home.modifiedTime = 1735732800 + static_cast<std::int64_t>(i);
+        homes.push_back(std::move(home));
+    }
+    return homes;
+}
+
+static void expectSameHomes(HomeStorage::Homes const& actual, HomeStorage::Homes const& expected) {
+    TPS_EXPECT(actual.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        TPS_EXPECT(actual[i].name == expected[i].name);
+        TPS_EXPECT(actual[i].x == expected[i].x && actual[i].y == expected[i].y && actual[i].z == expected[i].z);
+        TPS_EXPECT(actual[i].dimid == expected[i].dimid);
+        TPS_EXPECT(actual[i].createdTime == expected[i].createdTime);
+        TPS_EXPECT(actual[i].modifiedTime == expected[i].modifiedTime);
+    }
+}
+
+void RecordCodecTest() {
+    auto homes = makeHomes(16);
+    auto data  = HomeStorage::encodeHomes(homes);
+    expectSameHomes(HomeStorage::decodeHomes(data), homes);
+    TPS_EXPECT(HomeStorage::decodeHomes(HomeStorage::encodeHomes({})).empty());
+
+    // 截断: 任一前缀都不能被当作完整数据
+    for (std::size_t size = 1; size < data.size(); ++size) {
+        TPS_EXPECT_THROWS(HomeStorage::decodeHomes(std::string_view{data}.substr(0, size)));
+    }
+
+    // 损坏: 未知版本、记录数大于实际条数
+    auto badVersion = data;
+    badVersion[1]   = static_cast<char>(HomeStorage::BINARY_VERSION + 1);
+    TPS_EXPECT_THROWS(HomeStorage::decodeHomes(badVersion));
+    auto badCount = data;
+    badCount[2]   = 0x7F; // varint 单字节, 16 -> 127
+    TPS_EXPECT_THROWS(HomeStorage::decodeHomes(badCount));
+    TPS_EXPECT_THROWS(HomeStorage::decodeHomes(R"([{"name": "home", "x": 1.5,)"));
+
+    // v1 -> v2: 时间字符串迁移为时间戳, 重新编码后为当前版本
+    std::string const created  = "2025-01-01 12:00:00";
+    std::string const modified = "2025-06-01 08:30:00";
+
+    binary_utils::Writer writer;
+    writer.writeHeader(1).writeVarUInt(1);
+    writer.writeF32(1.5f).writeF32(64.0f).writeF32(-2.0f).writeI32(1);
+    writer.writeString("home").writeString(created).writeString(modified);
+    auto v1 = HomeStorage::decodeHomes(writer.release());
+    TPS_EXPECT(v1.size() == 1 && v1[0].name == "home" && v1[0].dimid == 1 && v1[0].z == -2.0f);
+    TPS_EXPECT(v1[0].createdTime != 0 && v1[0].createdTime == time_utils::parseEpoch(created));
+    TPS_EXPECT(v1[0].modifiedTime == time_utils::parseEpoch(modified));
+    TPS_EXPECT(time_utils::epochToString(v1[0].createdTime) == created);
+    auto v2 = HomeStorage::encodeHomes(v1);
+    TPS_EXPECT(static_cast<std::uint8_t>(v2[1]) == HomeStorage::BINARY_VERSION);
+    expectSameHomes(HomeStorage::decodeHomes(v2), v1);
+
+    // 旧版 JSON: 单个玩家的数组与 {realName: [home...]} 单键数据, 时间可为字符串或时间戳
+    auto json = HomeStorage::decodeHomes(
+        R"([{"x": 1.5, "y": 64, "z": -2, "dimid": 1, "name": "home", "createdTime": "2025-01-01 12:00:00",)"
+        R"( "modifiedTime": 1735732800}])"
+    );
+    TPS_EXPECT(json.size() == 1 && json[0].name == "home" && json[0].x == 1.5f && json[0].dimid == 1);
+    TPS_EXPECT(json[0].createdTime == time_utils::parseEpoch(created) && json[0].modifiedTime == 1735732800);
+
+    std::unordered_map<std::string, std::size_t> players;
+    HomeStorage::readLegacyHomes(
+        R"({"alice": [{"name": "a", "x": 1}, {"name": "b", "x": 2}], "bob": []})",
+        [&](std::string_view realName, HomeStorage::Homes homes) { players[std::string{realName}] = homes.size(); }
+    );
+    TPS_EXPECT(players.size() == 2 && players["alice"] == 2 && players["bob"] == 0);
+}
+
+
+#ifdef TPS_BENCHMARK
+static void benchmarkHomes(std::size_t count) {
+    auto homes = makeHomes(count);
+    auto tag   = std::to_string(count);
+
+    std::string jsonData;
+    {
+        time_utils::Timer timer{"json encode " + tag};
+        jsonData = json_utils::struct2json(homes).dump();
+    }
+    std::string binaryData;
+    {
+        time_utils::Timer timer{"binary encode " + tag};
+        binaryData = HomeStorage::encodeHomes(homes);
+    }
+
+    HomeStorage::Homes fromJson, fromBinary;
+    {
+        time_utils::Timer timer{"json decode " + tag};
+        fromJson = HomeStorage::decodeHomes(jsonData);
+    }
+    {
+        time_utils::Timer timer{"binary decode " + tag};
+        fromBinary = HomeStorage::decodeHomes(binaryData);
+    }
+
+    expectSameHomes(fromJson, homes);
+    expectSameHomes(fromBinary, homes);
+    std::cout << "homes: " << count << ", json bytes: " << jsonData.size() << ", binary bytes: " << binaryData.size()
+              << std::endl;
+}
+
+// 旧版单键数据 {realName: [home...]} 的加载: DOM + 反射 vs 流式解析
+static void benchmarkLegacyLoad(std::size_t players, std::size_t homesPerPlayer) {
+    std::string blob;
+    {
+        std::unordered_map<std::string, HomeStorage::Homes> map;
+        for (std::size_t i = 0; i < players; ++i) {
+            map.emplace("player_" + std::to_string(i), makeHomes(homesPerPlayer));
+        }
+        blob = json_utils::struct2json(map).dump();
+    }
+    auto tag = std::to_string(players) + "x" + std::to_string(homesPerPlayer);
+
+    // 原有加载路径: 整体解析为 DOM 后通过反射反序列化
+    std::size_t domHomes = 0;
+    {
+        time_utils::Timer                                   timer{"legacy dom load " + tag};
+        auto                                                json = nlohmann::json::parse(blob);
+        std::unordered_map<std::string, HomeStorage::Homes> map;
+        json_utils::json2struct(map, json);
+        for (auto const& [_, homes] : map) {
+            domHomes += homes.size();
+        }
+    }
+
+    std::size_t saxHomes = 0;
+    {
+        time_utils::Timer timer{"legacy stream load " + tag};
+        HomeStorage::readLegacyHomes(blob, [&](std::string_view, HomeStorage::Homes homes) {
+            saxHomes += homes.size();
+        });
+    }
+
+    TPS_EXPECT(domHomes == players * homesPerPlayer);
+    TPS_EXPECT(saxHomes == players * homesPerPlayer);
+    std::cout << "legacy bytes: " << blob.size() << std::endl;
+}
+
+
+void RecordCodecBenchmark() {
+    benchmarkHomes(100'000);
+    benchmarkHomes(1'000'000);
+    benchmarkLegacyLoad(10'000, 20);
+}
+#endif
+
+
+} // namespace ltps::test
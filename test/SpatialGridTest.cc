@@ -0,0 +1,134 @@
+#include "TestUtils.h"
+#include "ltps/common/SpatialGrid.h"
+#include "ltps/utils/TimeUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ltps::test {
+
+
+using Grid = SpatialGrid<std::string>;
+
+static bool sameKeys(std::vector<Grid::Hit> const& hits, std::vector<std::string> const& keys) {
+    if (hits.size() != keys.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (hits[i].key != keys[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SpatialGridTest() {
+    // 跨格子边界: 格子边长 16, 同格子的点比相邻格子 (含负坐标与对角格子) 的点更远
+    Grid grid{16.0f};
+    grid.insert("same-cell", 0, 15.0f, 64.0f, 1.0f);
+    grid.insert("west", 0, -0.25f, 64.0f, 1.0f);
+    grid.insert("diagonal", 0, -0.5f, 64.0f, -0.5f);
+    grid.insert("east", 0, 16.5f, 64.0f, 1.0f);
+
+    TPS_EXPECT(sameKeys(grid.nearest(0, 0.25f, 64.0f, 1.0f, 1), {"west"}));
+    TPS_EXPECT(sameKeys(grid.nearest(0, 0.25f, 64.0f, 0.25f, 2), {"west", "diagonal"}));
+    TPS_EXPECT(sameKeys(grid.nearest(0, 15.75f, 64.0f, 1.0f, 2), {"same-cell", "east"}));
+    TPS_EXPECT(sameKeys(grid.nearest(0, 0.25f, 64.0f, 1.0f, 10), {"west", "diagonal", "same-cell", "east"}));
+    TPS_EXPECT(sameKeys(grid.nearest(0, 0.25f, 64.0f, 1.0f, 10, 2.0f), {"west", "diagonal"}));
+    TPS_EXPECT(sameKeys(grid.withinRadius(0, 0.25f, 64.0f, 1.0f, 1.0f), {"west"}));
+    TPS_EXPECT(sameKeys(grid.withinRadius(0, 16.0f, 64.0f, 1.0f, 1.0f), {"east", "same-cell"}));
+    TPS_EXPECT(grid.withinRadius(0, 8.0f, 64.0f, 1.0f, 0.5f).empty());
+
+    // 移动到另一个格子后只在新位置命中
+    grid.insert("west", 0, 40.0f, 64.0f, 1.0f);
+    TPS_EXPECT(grid.size() == 4);
+    TPS_EXPECT(sameKeys(grid.nearest(0, 0.25f, 64.0f, 1.0f, 1), {"diagonal"}));
+    TPS_EXPECT(sameKeys(grid.withinRadius(0, 40.0f, 64.0f, 1.0f, 0.5f), {"west"}));
+
+    // 维度隔离: 坐标相同的点只在各自维度命中, 更新维度后从原维度移除
+    Grid dims{16.0f};
+    dims.insert("overworld", 0, 0.0f, 64.0f, 0.0f);
+    dims.insert("nether", 1, 0.0f, 64.0f, 0.0f);
+    dims.insert("nether-far", 1, 100.0f, 64.0f, 0.0f);
+    TPS_EXPECT(sameKeys(dims.nearest(0, 0.0f, 64.0f, 0.0f, 10), {"overworld"}));
+    TPS_EXPECT(sameKeys(dims.nearest(1, 0.0f, 64.0f, 0.0f, 10), {"nether", "nether-far"}));
+    TPS_EXPECT(dims.nearest(2, 0.0f, 64.0f, 0.0f, 10).empty());
+    TPS_EXPECT(dims.withinRadius(2, 0.0f, 64.0f, 0.0f, 1'000.0f).empty());
+
+    dims.insert("overworld", 2, 0.0f, 64.0f, 0.0f);
+    TPS_EXPECT(dims.nearest(0, 0.0f, 64.0f, 0.0f, 10).empty());
+    TPS_EXPECT(sameKeys(dims.nearest(2, 0.0f, 64.0f, 0.0f, 10), {"overworld"}));
+
+    TPS_EXPECT(dims.erase("nether") && !dims.erase("nether"));
+    TPS_EXPECT(sameKeys(dims.nearest(1, 0.0f, 64.0f, 0.0f, 10), {"nether-far"}));
+    TPS_EXPECT(!dims.contains("nether") && dims.size() == 2);
+}
+
+
+#ifdef TPS_BENCHMARK
+// 每个维度 count 个随机点, 与暴力遍历对比结果并统计查询耗时
+static void benchmarkSpatialGrid(std::size_t count, std::size_t queries) {
+    struct Point {
+        int   dimid;
+        float x, y, z;
+    };
+    std::mt19937                          rng{42};
+    std::uniform_real_distribution<float> horizontal{-30'000.0f, 30'000.0f}, vertical{-64.0f, 320.0f};
+
+    std::vector<Point>       points;
+    SpatialGrid<std::size_t> grid;
+    for (std::size_t i = 0; i < count * 3; ++i) {
+        points.push_back({static_cast<int>(i % 3), horizontal(rng), vertical(rng), horizontal(rng)});
+        grid.insert(i, points[i].dimid, points[i].x, points[i].y, points[i].z);
+    }
+
+    auto bruteForce = [&](int dimid, float x, float y, float z, std::size_t limit) {
+        std::vector<float> distances;
+        for (auto const& p : points) {
+            if (p.dimid == dimid) {
+                distances.push_back(std::hypot(p.x - x, p.y - y, p.z - z));
+            }
+        }
+        std::sort(distances.begin(), distances.end());
+        distances.resize(std::min(limit, distances.size()));
+        return distances;
+    };
+
+    std::vector<Point> probes;
+    for (std::size_t i = 0; i < queries; ++i) {
+        probes.push_back({static_cast<int>(i % 3), horizontal(rng), vertical(rng), horizontal(rng)});
+    }
+
+    std::vector<std::vector<SpatialGrid<std::size_t>::Hit>> results;
+    {
+        time_utils::Timer timer{"spatial grid nearest x" + std::to_string(queries)};
+        for (auto const& p : probes) {
+            results.push_back(grid.nearest(p.dimid, p.x, p.y, p.z, 10));
+        }
+    }
+
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < queries; ++i) {
+        auto expected = bruteForce(probes[i].dimid, probes[i].x, probes[i].y, probes[i].z, 10);
+        for (std::size_t k = 0; k < expected.size(); ++k) {
+            if (k >= results[i].size() || std::abs(results[i][k].distance - expected[k]) > 1e-2f) {
+                ++mismatches;
+                break;
+            }
+        }
+    }
+
+    TPS_EXPECT(mismatches == 0);
+    std::cout << "spatial grid points/dim: " << count << ", queries: " << queries << std::endl;
+}
+
+
+void SpatialGridBenchmark() { benchmarkSpatialGrid(20'000, 1'000); }
+#endif
+
+
+} // namespace ltps::test
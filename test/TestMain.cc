@@ -1,11 +1,69 @@
-
-
+#include <cstddef>
+#include <exception>
+#include <iostream>
 
 namespace ltps::test {
 
+extern void BatchQueueTest();
+extern void BlockPoolTest();
+extern void CoordinateColumnsTest();
+extern void PairIndexTest();
 extern void PriceCalculateTest();
+extern void RecordCodecTest();
+extern void SpatialGridTest();
+extern void TimingWheelTest();
+
+#ifdef TPS_BENCHMARK
+extern void BatchQueueBenchmark();
+extern void BlockPoolBenchmark();
+extern void CoordinateColumnsBenchmark();
+extern void PairIndexBenchmark();
+extern void RecordCodecBenchmark();
+extern void SpatialGridBenchmark();
+extern void TimingWheelBenchmark();
+#endif
+
+// 运行单个测试, 断言失败或抛出异常时返回 false
+static bool run(char const* name, void (*test)()) {
+    try {
+        test();
+    } catch (std::exception const& e) {
+        std::cout << "[FAILED] " << name << ": " << e.what() << std::endl;
+        return false;
+    }
+    std::cout << "[ok] " << name << std::endl;
+    return true;
+}
+
+// 返回是否全部通过, 任一测试失败时插件启用失败
+bool Test_Main() {
+    std::size_t failed = 0;
+
+    failed += !run("BatchQueueTest", BatchQueueTest);
+    failed += !run("BlockPoolTest", BlockPoolTest);
+    failed += !run("CoordinateColumnsTest", CoordinateColumnsTest);
+    failed += !run("PairIndexTest", PairIndexTest);
+    failed += !run("PriceCalculateTest", PriceCalculateTest);
+    failed += !run("RecordCodecTest", RecordCodecTest);
+    failed += !run("SpatialGridTest", SpatialGridTest);
+    failed += !run("TimingWheelTest", TimingWheelTest);
+
+#ifdef TPS_BENCHMARK
+    // 百万级数据的性能测试耗时较长, 仅在 xmake f --test=y --benchmark=y 时运行
+    failed += !run("BatchQueueBenchmark", BatchQueueBenchmark);
+    failed += !run("BlockPoolBenchmark", BlockPoolBenchmark);
+    failed += !run("CoordinateColumnsBenchmark", CoordinateColumnsBenchmark);
+    failed += !run("PairIndexBenchmark", PairIndexBenchmark);
+    failed += !run("RecordCodecBenchmark", RecordCodecBenchmark);
+    failed += !run("SpatialGridBenchmark", SpatialGridBenchmark);
+    failed += !run("TimingWheelBenchmark", TimingWheelBenchmark);
+#endif
 
-void Test_Main() { PriceCalculateTest(); }
+    if (failed != 0) {
+        std::cout << failed << " test(s) failed" << std::endl;
+    }
+    return failed == 0;
+}
 
 
 } // namespace ltps::test
@@ -0,0 +1,30 @@
+#pragma once
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+// 断言失败时抛出 std::runtime_error, 由 Test_Main 记录并使本次测试运行失败
+#define TPS_EXPECT(...)                                                                                                \
+    do {                                                                                                               \
+        if (!(__VA_ARGS__)) {                                                                                          \
+            throw std::runtime_error(                                                                                  \
+                std::string{__FILE__} + ":" + std::to_string(__LINE__) + ": expected " + #__VA_ARGS__                  \
+            );                                                                                                         \
+        }                                                                                                              \
+    } while (false)
+
+// 表达式必须抛出 std::exception
+#define TPS_EXPECT_THROWS(...)                                                                                         \
+    do {                                                                                                               \
+        bool thrown = false;                                                                                           \
+        try {                                                                                                          \
+            (void)(__VA_ARGS__);                                                                                       \
+        } catch (std::exception const&) {                                                                              \
+            thrown = true;                                                                                             \
+        }                                                                                                              \
+        if (!thrown) {                                                                                                 \
+            throw std::runtime_error(                                                                                  \
+                std::string{__FILE__} + ":" + std::to_string(__LINE__) + ": expected exception from " + #__VA_ARGS__   \
+            );                                                                                                         \
+        }                                                                                                              \
+    } while (false)
@@ -0,0 +1,233 @@
+#include "TestUtils.h"
+#include "ltps/common/TimingWheel.h"
+#include "ltps/utils/TimeUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ltps::test {
+
+
+using Wheel = TimingWheel<int>;
+
+// 推进到 deadline 的前一个 tick 不应触发, 推进到 deadline 时恰好触发 value
+static void expectFiresAt(Wheel& wheel, Wheel::TimePoint deadline, int value) {
+    std::vector<int> expired;
+    wheel.advance(deadline - wheel.tick(), expired);
+    TPS_EXPECT(expired.empty());
+    wheel.advance(deadline, expired);
+    TPS_EXPECT((expired == std::vector<int>{value}));
+}
+
+void TimingWheelTest() {
+    using namespace std::chrono;
+    auto const origin = Wheel::TimePoint{} + hours{1};
+    auto const at     = [&](std::int64_t ms) { return origin + milliseconds{ms}; };
+
+    // 第 2 / 3 层及超出可定位范围的到期时间, 需要逐层级联到第 0 层
+    {
+        Wheel wheel{milliseconds{1}, origin};
+        wheel.insert(at(5'000), 2); // 第 2 层: >= 64^2 tick
+        expectFiresAt(wheel, at(5'000), 2);
+        wheel.insert(at(5'000 + 300'007), 3); // 第 3 层: >= 64^3 tick, 且起点不在槽边界
+        expectFiresAt(wheel, at(5'000 + 300'007), 3);
+        wheel.insert(at(305'007 + 16'777'316), 4); // 超出 64^4 tick, 先挂在最高层
+        expectFiresAt(wheel, at(305'007 + 16'777'316), 4);
+        TPS_EXPECT(wheel.empty());
+    }
+
+    // 跨层混合插入后一次推进, 按到期顺序输出
+    {
+        Wheel            wheel{milliseconds{1}, origin};
+        std::vector<int> expired;
+        wheel.advance(at(70), expired); // 使当前 tick 不在槽边界上
+        for (int ms : {262'200, 63, 4'159, 4'095, 64, 262'143, 1}) {
+            wheel.insert(at(70 + ms), ms);
+        }
+        wheel.advance(at(70 + 262'199), expired);
+        TPS_EXPECT((expired == std::vector<int>{1, 63, 64, 4'095, 4'159, 262'143}));
+        expectFiresAt(wheel, at(70 + 262'200), 262'200);
+    }
+
+    // 已取消的句柄在槽位复用后再次取消无效, 不影响新的定时器
+    {
+        Wheel wheel{milliseconds{1}, origin};
+        auto  stale = wheel.insert(at(10), 1);
+        TPS_EXPECT(wheel.cancel(stale));
+        TPS_EXPECT(!wheel.cancel(stale));
+        auto fresh = wheel.insert(at(20), 2);
+        TPS_EXPECT(fresh.index == stale.index && fresh.generation != stale.generation);
+        TPS_EXPECT(!wheel.contains(stale) && !wheel.cancel(stale));
+        TPS_EXPECT(wheel.contains(fresh) && wheel.size() == 1);
+        expectFiresAt(wheel, at(20), 2);
+    }
+
+    // 已触发的句柄取消无效
+    {
+        Wheel wheel{milliseconds{1}, origin};
+        auto  handle = wheel.insert(at(3), 3);
+        expectFiresAt(wheel, at(3), 3);
+        TPS_EXPECT(!wheel.contains(handle) && !wheel.cancel(handle));
+        TPS_EXPECT(wheel.empty());
+    }
+
+    // nextWakeup 随插入与取消更新, 到期时间向上取整到 tick
+    {
+        Wheel wheel{milliseconds{1}, origin};
+        TPS_EXPECT(!wheel.nextWakeup());
+        auto near = wheel.insert(at(10), 1);
+        TPS_EXPECT(wheel.nextWakeup() == at(10));
+        auto rounded = wheel.insert(at(5) + microseconds{500}, 2);
+        TPS_EXPECT(wheel.nextWakeup() == at(6));
+        auto far = wheel.insert(at(5'000), 3);
+        TPS_EXPECT(wheel.nextWakeup() == at(6));
+        TPS_EXPECT(wheel.cancel(rounded) && wheel.cancel(near));
+        TPS_EXPECT(wheel.nextWakeup() == at(64)); // 只剩高层定时器时在下一次级联时唤醒
+        TPS_EXPECT(wheel.cancel(far));
+        TPS_EXPECT(!wheel.nextWakeup());
+    }
+}
+
+
+#ifdef TPS_BENCHMARK
+struct ChurnRequest {
+    std::size_t                           id;
+    std::chrono::steady_clock::time_point expire;
+    bool                                  resolved{false};
+
+    inline static std::size_t alive = 0;
+
+    ChurnRequest(std::size_t id, std::chrono::steady_clock::time_point expire) : id(id), expire(expire) { ++alive; }
+    ~ChurnRequest() { --alive; }
+
+    [[nodiscard]] std::chrono::steady_clock::time_point getExpireTime() const { return expire; }
+};
+
+struct ChurnResult {
+    std::size_t expired{0};
+    std::size_t peakAlive{0};
+};
+
+// 模拟 minutes 分钟内每分钟 perMinute 个 TPA 请求, 有效期 120 秒, resolvedRatio 的请求在 30 秒内被处理,
+// 以 50ms 为一帧推进, 分别用原先的二叉堆 (处理后懒删除) 与时间轮 (处理后立即取消) 调度
+static void benchmarkTimingWheel(std::size_t perMinute, std::size_t minutes, double resolvedRatio) {
+    using namespace std::chrono;
+    using Request = std::shared_ptr<ChurnRequest>;
+
+    auto const origin   = steady_clock::now();
+    auto const interval = milliseconds{60'000} / static_cast<std::int64_t>(perMinute);
+    auto const total    = perMinute * minutes;
+    auto const end      = milliseconds{static_cast<std::int64_t>(minutes) * 60'000 + 130'000};
+    auto const frame    = milliseconds{50};
+
+    std::mt19937                                      rng{42};
+    std::uniform_real_distribution<double>            chance{0.0, 1.0};
+    std::uniform_int_distribution<int>                delay{0, 30'000};
+    std::vector<std::pair<milliseconds, std::size_t>> resolutions; // 处理时间 -> 请求序号
+    for (std::size_t i = 0; i < total; ++i) {
+        if (chance(rng) < resolvedRatio) {
+            resolutions.emplace_back(interval * static_cast<std::int64_t>(i) + milliseconds{delay(rng)}, i);
+        }
+    }
+    std::sort(resolutions.begin(), resolutions.end());
+
+    // 逐帧回放创建与处理事件, create / resolve / advance 由具体调度方式实现
+    auto replay = [&](auto&& create, auto&& resolve, auto&& advance) {
+        ChurnResult result;
+        std::size_t created = 0, resolved = 0;
+        for (milliseconds now{0}; now <= end; now += frame) {
+            for (; created < total && interval * static_cast<std::int64_t>(created) <= now; ++created) {
+                create(created, origin + interval * static_cast<std::int64_t>(created) + seconds{120});
+            }
+            for (; resolved < resolutions.size() && resolutions[resolved].first <= now; ++resolved) {
+                resolve(resolutions[resolved].second);
+            }
+            result.expired  += advance(origin + now);
+            result.peakAlive = std::max(result.peakAlive, ChurnRequest::alive);
+        }
+        return result;
+    };
+
+    ChurnResult heapResult;
+    {
+        auto later = [](Request const& lhs, Request const& rhs) { return lhs->expire > rhs->expire; };
+        std::priority_queue<Request, std::vector<Request>, decltype(later)> heap{later};
+        std::unordered_map<std::size_t, Request>                            live;
+
+        time_utils::Timer timer{"heap churn " + std::to_string(total)};
+        heapResult = replay(
+            [&](std::size_t id, steady_clock::time_point expire) {
+                auto request = Request{new ChurnRequest{id, expire}};
+                heap.push(request);
+                live.emplace(id, std::move(request));
+            },
+            [&](std::size_t id) {
+                if (auto iter = live.find(id); iter != live.end()) {
+                    iter->second->resolved = true; // 仍留在堆中直到到期
+                    live.erase(iter);
+                }
+            },
+            [&](steady_clock::time_point now) {
+                std::size_t expired = 0;
+                while (!heap.empty() && heap.top()->expire <= now) {
+                    if (!heap.top()->resolved) {
+                        live.erase(heap.top()->id);
+                        ++expired;
+                    }
+                    heap.pop();
+                }
+                return expired;
+            }
+        );
+    }
+
+    ChurnResult wheelResult;
+    {
+        TimingWheel<Request> wheel{milliseconds{50}, origin};
+        std::unordered_map<std::size_t, TimingWheel<Request>::Handle> live;
+        std::vector<Request>                                          expired;
+
+        time_utils::Timer timer{"timing wheel churn " + std::to_string(total)};
+        wheelResult = replay(
+            [&](std::size_t id, steady_clock::time_point expire) {
+                live.emplace(id, wheel.insert(expire, Request{new ChurnRequest{id, expire}}));
+            },
+            [&](std::size_t id) {
+                if (auto iter = live.find(id); iter != live.end()) {
+                    wheel.cancel(iter->second); // 立即释放
+                    live.erase(iter);
+                }
+            },
+            [&](steady_clock::time_point now) {
+                expired.clear();
+                wheel.advance(now, expired);
+                for (auto const& request : expired) {
+                    live.erase(request->id);
+                }
+                return expired.size();
+            }
+        );
+    }
+
+    TPS_EXPECT(heapResult.expired == wheelResult.expired && ChurnRequest::alive == 0);
+    std::cout << "timing wheel requests: " << total << ", expired: " << wheelResult.expired
+              << ", peak alive (heap / wheel): " << heapResult.peakAlive << " / " << wheelResult.peakAlive
+              << std::endl;
+}
+
+
+void TimingWheelBenchmark() { benchmarkTimingWheel(10'000, 60, 0.8); }
+#endif
+
+
+} // namespace ltps::test
@@ -20,6 +20,11 @@ option("test")
     set_showmenu(true)
 option_end()
 
+option("benchmark") -- 需同时开启 test, 启动时额外运行百万级数据的性能测试
+    set_default(false)
+    set_showmenu(true)
+option_end()
+
 rule("gen_version")
     before_build(function(target)
         import("scripts.gen_version")()
@@ -71,6 +76,9 @@ target("TeleportSystem")
         add_defines("TPS_TEST")
         add_includedirs("test")
         add_files("test/**.cc")
+        if has_config("benchmark") then
+            add_defines("TPS_BENCHMARK")
+        end
     end
 
     add_defines("MOD_NAME=\"TeleportSystem\"")